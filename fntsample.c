@@ -13,59 +13,50 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
-#include <ft2build.h>
-#include FT_FREETYPE_H
-#include FT_SFNT_NAMES_H
-#include FT_TYPE1_TABLES_H
 #include <cairo.h>
 #include <cairo-pdf.h>
 #include <cairo-ps.h>
 #include <cairo-svg.h>
-#include <cairo-ft.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <glib.h>
 #include <stdbool.h>
 #include <unistd.h>
+#include <fcntl.h>
 #include <getopt.h>
 #include <stdint.h>
-#include <pango/pangocairo.h>
-#include <math.h>
+#include <limits.h>
 #include <libintl.h>
 #include <locale.h>
-#include <wchar.h>
+#include <errno.h>
 
-#include "unicode_blocks.h"
-#include "ucd_xml_reader.h"
+#include "libfntsample.h"
+#include "render_server.h"
+#include "stream_writer.h"
 #include "config.h"
 
 #define _(str)	gettext(str)
 
-#define A4_WIDTH	(8.3*72)
-#define A4_HEIGHT	(11.7*72)
-
-#define xmin_border	(72.0/1.5)
-#define ymin_border	(72.0)
-#define cell_width	((A4_WIDTH - 2*xmin_border) / 16)
-#define cell_height	((A4_HEIGHT - 2*ymin_border) / 16)
-
-#define CELL_X(x_min, N)	((x_min) + cell_width * ((N) / 16))
-#define CELL_Y(N)	(ymin_border + cell_height * ((N) % 16))
+/* Rendering goes on while the writer thread drains this much output */
+#define OUTPUT_BUFFER_SIZE (8 * 1024 * 1024)
 
 static struct option longopts[] = { { "font-file", 1, 0, 'f' }, { "output-file",
     1, 0, 'o' }, { "help", 0, 0, 'h' }, { "other-font-file", 1, 0, 'd' }, {
     "postscript-output", 0, 0, 's' }, { "svg", 0, 0, 'g' }, { "print-outline",
     0, 0, 'l' }, { "include-range", 1, 0, 'i' }, { "exclude-range", 1, 0, 'x' },
     { "style", 1, 0, 't' }, { "font-index", 1, 0, 'n' }, { "other-index", 1, 0,
-        'm' }, { "ucd-xml-file", 1, 0, 'r' }, { 0, 0, 0, 0 } };
-
-struct range {
-  uint32_t first;
-  uint32_t last;
-  bool include;
-  struct range *next;
-};
+        'm' }, { "ucd-xml-file", 1, 0, 'r' }, { "compact", 2, 0, 'c' }, { "server",
+    1, 0, 'S' }, { "client", 1, 0, 'C' }, { "jobs", 1, 0, 'j' }, {
+    "label-font-file", 1, 0, 'L' }, { "diff-glyphs", 0, 0, 'D' }, { "report", 1,
+    0, 'R' }, { "svg-pages", 0, 0, 'P' }, { "progress-fd", 1, 0, 'p' }, { "trace",
+    1, 0, 'T' }, { "instances", 1, 0, 'I' }, { "split-instances", 0, 0, 'X' },
+    { "overview", 2, 0, 'O' }, { "plan", 1, 0, 'M' },
+    { "export", 1, 0, 'E' }, { "grid", 1, 0, 'G' },
+    { "cache-dir", 1, 0, 'K' }, { "pages", 1, 0, 'A' }, { 0, 0, 0, 0 } };
+
+static const char shortopts[] =
+    "f:o:hd:sgli:x:t:n:m:r:c::S:C:j:L:DR:Pp:T:I:XO::M:E:G:K:A:";
 
 static const char *font_file_name;
 static const char *other_font_file_name;
@@ -73,74 +64,42 @@ static const char *output_file_name;
 static const char *xml_file_name = NULL;
 static bool postscript_output;
 static bool svg_output;
+static bool svg_pages_output;
 static bool print_outline;
-static struct range *ranges;
-static struct range *last_range;
+static const char *report_format;
+static const char *plan_format;
+static const char *export_format;
 static int font_index;
 static int other_index;
-
-struct fntsample_style {
-  const char * const name;
-  const char * const default_val;
-  char *val;
-};
-
-static struct fntsample_style styles[] = {
-    { "header-font", "Sans Bold 12", NULL }, { "font-name-font",
-        "Serif Bold 12", NULL }, { "table-numbers-font", "Sans 10", NULL }, {
-        "cell-numbers-font", "Mono 8", NULL }, { NULL, NULL, NULL } };
-
-static PangoFontDescription *header_font;
-static PangoFontDescription *font_name_font;
-static PangoFontDescription *table_numbers_font;
-static PangoFontDescription *cell_numbers_font;
-
-static double cell_label_offset;
-static double cell_glyph_bot_offset;
-static double glyph_baseline_offset;
+static const char *server_socket;
+static const char *client_socket;
+static unsigned int server_jobs;
+static int progress_fd = -1;
+static const char *trace_file_name;
+static const char *instances_spec;
+static bool split_instances;
+
+/* Output file, surfaces write to it with write_output() */
+static struct stream_writer *output;
+static unsigned long long output_bytes;
+
+/* Number of recent pages the current rate is measured over */
+#define RATE_WINDOW 16
+
+/* State of the --progress-fd event stream */
+static struct {
+  FILE *out;
+  gint64 start; /* all times are in microseconds */
+  gint64 block_start;
+  gint64 page_times[RATE_WINDOW]; /* finish times of the recent pages */
+  int pages;
+} progress;
+
+/* Renderer state, options are stored directly into it */
+static struct fntsample_context *ctx;
 
 static void usage(const char *);
 
-static struct fntsample_style *find_style(const char *name) {
-  struct fntsample_style *style = styles;
-
-  for (; style->name; style++) {
-    if (!strcmp(name, style->name))
-      return style;
-  }
-
-  return NULL;
-}
-
-static int set_style(const char *name, const char *val) {
-  struct fntsample_style *style;
-  char *new_val;
-
-  style = find_style(name);
-
-  if (!style)
-    return -1;
-
-  new_val = strdup(val);
-  if (!new_val)
-    return -1;
-
-  if (style->val)
-    free(style->val);
-  style->val = new_val;
-
-  return 0;
-}
-
-static const char *get_style(const char *name) {
-  struct fntsample_style *style = find_style(name);
-
-  if (!style)
-    return NULL;
-
-  return style->val ? style->val : style->default_val;
-}
-
 static int parse_style_string(char *s) {
   char *n;
 
@@ -148,7 +107,7 @@ static int parse_style_string(char *s) {
   if (!n)
     return -1;
   *n++ = '\0';
-  return set_style(s, n);
+  return fntsample_set_style(ctx, s, n);
 }
 
 /*
@@ -157,7 +116,6 @@ static int parse_style_string(char *s) {
  * Returns -1 on error.
  */
 static int add_range(char *range, bool include) {
-  struct range *r;
   uint32_t first = 0, last = 0xffffffff;
   char *minus;
   char *endptr;
@@ -190,113 +148,79 @@ static int add_range(char *range, bool include) {
   if (first > last)
     return -1;
 
-  r = malloc(sizeof(*r));
-  if (!r)
-    return -1;
-
-  r->first = first;
-  r->last = last;
-  r->include = include;
-  r->next = NULL;
-
-  if (ranges)
-    last_range->next = r;
-  else ranges = r;
-
-  last_range = r;
-
-  return 0;
-}
-
-/*
- * Check if character with the given code belongs
- * to output range specified by the user.
- */
-static bool in_range(uint32_t c) {
-  bool in = ranges ? (!ranges->include) : 1;
-  struct range *r;
-
-  for (r = ranges; r; r = r->next) {
-    if ((c >= r->first) && (c <= r->last))
-      in = r->include;
-  }
-  return in;
+  return fntsample_add_range(ctx, first, last, include);
 }
 
 /*
- * Get glyph index for the next glyph from the given font face, that
- * represents character from output range specified by the user.
+ * Set the range of pages to draw: FIRST-LAST, FIRST-, -LAST or a single
+ * page.
  *
- * Returns character code, updates 'idx'.
- * 'idx' can became 0 if there are no more glyphs.
- */
-static FT_ULong get_next_char(FT_Face face, FT_ULong charcode, FT_UInt *idx) {
-  FT_ULong rval = charcode;
-
-  do {
-    rval = FT_Get_Next_Char(face, rval, idx);
-  } while (*idx && !in_range(rval));
-
-  return rval;
-}
-
-/*
- * Locate first character from the given font face that belongs
- * to the user-specified output range.
- *
- * Returns character code, updates 'idx' with glyph index.
- * Glyph index can became 0 if there are no matching glyphs in the font.
+ * Returns -1 on error.
  */
-static FT_ULong get_first_char(FT_Face face, FT_UInt *idx) {
-  FT_ULong rval;
-
-  rval = FT_Get_First_Char(face, idx);
+static int set_pages(char *range) {
+  long first = 1, last = 0;
+  char *minus;
+  char *endptr;
 
-  if (*idx && !in_range(rval))
-    rval = get_next_char(face, rval, idx);
+  minus = strchr(range, '-');
 
-  return rval;
-}
+  if (minus) {
+    if (minus != range) {
+      *minus = '\0';
+      first = strtol(range, &endptr, 10);
+      if (*endptr)
+        return -1;
+    }
 
-/*
- * Create Pango layout for the given text.
- * Updates 'r' with text extents.
- * Returned layout should be freed using g_object_unref().
- */
-static PangoLayout *layout_text(cairo_t *cr, PangoFontDescription *ftdesc,
-    const char *text, PangoRectangle *r) {
-  PangoLayout *layout;
+    if (*(minus + 1)) {
+      last = strtol(minus + 1, &endptr, 10);
+      if (*endptr || last < 1)
+        return -1;
+    }
+    else if (minus == range)
+      return -1;
+  }
+  else {
+    first = strtol(range, &endptr, 10);
+    if (*endptr)
+      return -1;
+    last = first;
+  }
 
-  layout = pango_cairo_create_layout(cr);
-  pango_layout_set_font_description(layout, ftdesc);
-  pango_layout_set_text(layout, text, -1);
-  pango_layout_get_extents(layout, r, NULL);
+  if (first < 1 || first > INT_MAX || last > INT_MAX)
+    return -1;
 
-  return layout;
+  return fntsample_set_pages(ctx, first, last);
 }
 
 static void parse_options(int argc, char * const argv[]) {
+  /* Options of the render server are defaults that its jobs can override */
+  bool font_given = false, other_font_given = false, output_given = false,
+      xml_given = false;
+
   for (;;) {
     int c;
 
-    c = getopt_long(argc, argv, "f:o:hd:sgli:x:t:n:m:r:", longopts, NULL);
+    c = getopt_long(argc, argv, shortopts, longopts, NULL);
 
     if (c == -1)
       break;
 
     switch (c) {
       case 'f':
-        if (font_file_name) {
+        if (font_given) {
           fprintf(stderr, _("Font file name should be given only once!\n"));
           exit(1);
         }
+        font_given = true;
         font_file_name = optarg;
         break;
       case 'o':
-        if (output_file_name) {
+        if (output_given) {
           fprintf(stderr, _("Output file name should be given only once!\n"));
           exit(1);
         }
+        output_given = true;
         output_file_name = optarg;
         break;
       case 'h':
@@ -304,10 +228,11 @@ static void parse_options(int argc, char * const argv[]) {
         exit(0);
         break;
       case 'd':
-        if (other_font_file_name) {
+        if (other_font_given) {
           fprintf(stderr, _("Font file name should be given only once!\n"));
           exit(1);
         }
+        other_font_given = true;
         other_font_file_name = optarg;
         break;
       case 's':
@@ -316,6 +241,9 @@ static void parse_options(int argc, char * const argv[]) {
       case 'g':
         svg_output = true;
         break;
+      case 'P':
+        svg_pages_output = true;
+        break;
       case 'l':
         print_outline = true;
         break;
@@ -327,7 +255,7 @@ static void parse_options(int argc, char * const argv[]) {
         }
         break;
       case 't':
-        if (parse_style_string(optarg) == -1) {
+        if (parse_style_string(optarg)) {
           usage(argv[0]);
           exit(1);
         }
@@ -339,12 +267,121 @@ static void parse_options(int argc, char * const argv[]) {
         other_index = atoi(optarg);
         break;
       case 'r':
-        if (xml_file_name) {
+        if (xml_given) {
           fprintf(stderr, _("XML file name should be given only once!\n"));
           exit(1);
         }
+        xml_given = true;
         xml_file_name = optarg;
         break;
+      case 'c': {
+        int threshold = 25; /* percent of block covered by the font */
+
+        if (optarg) {
+          char *endptr;
+
+          threshold = strtol(optarg, &endptr, 10);
+          if (*endptr || threshold < 0 || threshold > 100) {
+            fprintf(stderr, _("Compact threshold should be between 0 and 100!\n"));
+            exit(1);
+          }
+        }
+        fntsample_set_compact(ctx, true, threshold);
+        break;
+      }
+      case 'G': {
+        unsigned int columns, rows;
+        char end;
+
+        if (sscanf(optarg, "%ux%u%c", &columns, &rows, &end) != 2
+            || fntsample_set_grid(ctx, columns, rows)) {
+          fprintf(stderr, _("Grid should be COLUMNSxROWS, both between 1 and 64!\n"));
+          exit(1);
+        }
+        break;
+      }
+      case 'A':
+        if (set_pages(optarg)) {
+          fprintf(stderr, _("Page range should be FIRST-LAST, with pages counted from 1!\n"));
+          exit(1);
+        }
+        break;
+      case 'S':
+        server_socket = optarg;
+        break;
+      case 'C':
+        client_socket = optarg;
+        break;
+      case 'j':
+        server_jobs = atoi(optarg);
+        if (server_jobs < 1) {
+          fprintf(stderr, _("Number of jobs should be positive!\n"));
+          exit(1);
+        }
+        break;
+      case 'R':
+        if (strcmp(optarg, "json") && strcmp(optarg, "csv")) {
+          usage(argv[0]);
+          exit(1);
+        }
+        report_format = optarg;
+        break;
+      case 'M':
+        if (strcmp(optarg, "json") && strcmp(optarg, "csv")) {
+          usage(argv[0]);
+          exit(1);
+        }
+        plan_format = optarg;
+        break;
+      case 'E':
+        if (strcmp(optarg, "json") && strcmp(optarg, "html")) {
+          usage(argv[0]);
+          exit(1);
+        }
+        export_format = optarg;
+        break;
+      case 'D':
+        fntsample_set_highlight_changed(ctx, true);
+        break;
+      case 'O':
+        if (optarg && strcmp(optarg, "first")) {
+          usage(argv[0]);
+          exit(1);
+        }
+        fntsample_set_overview(ctx,
+            optarg ? FNTSAMPLE_OVERVIEW_FIRST : FNTSAMPLE_OVERVIEW_ONLY);
+        break;
+      case 'p': {
+        char *endptr;
+
+        progress_fd = strtol(optarg, &endptr, 10);
+        if (*endptr || progress_fd < 0) {
+          fprintf(stderr, _("Progress file descriptor should be non-negative!\n"));
+          exit(1);
+        }
+        break;
+      }
+      case 'T':
+        trace_file_name = optarg;
+        break;
+      case 'I':
+        instances_spec = optarg;
+        break;
+      case 'X':
+        split_instances = true;
+        break;
+      case 'K':
+        if (fntsample_set_cache_dir(ctx, optarg)) {
+          perror("malloc");
+          exit(1);
+        }
+        break;
+      case 'L':
+        if (fntsample_add_label_font_file(ctx, optarg)) {
+          perror("malloc");
+          exit(1);
+        }
+        break;
       case '?':
       default:
         usage(argv[0]);
@@ -352,1048 +389,622 @@ static void parse_options(int argc, char * const argv[]) {
         break;
     }
   }
-  if (!font_file_name || !output_file_name) {
+  if (server_socket && client_socket) {
+    fprintf(stderr, _("--server and --client cannot be used together!\n"));
+    exit(1);
+  }
+  if (!server_socket
+      && (!font_file_name
+          || (!output_file_name && !report_format && !plan_format
+              && !export_format))) {
     usage(argv[0]);
     exit(1);
   }
+  if (!!report_format + !!plan_format + !!export_format > 1) {
+    fprintf(stderr, _("Only one of --report, --plan and --export can be used!\n"));
+    exit(1);
+  }
   if (font_index < 0 || other_index < 0) {
     fprintf(stderr, _("Font index should be non-negative!\n"));
     exit(1);
   }
-  if (postscript_output && svg_output) {
+  if (postscript_output && (svg_output || svg_pages_output)) {
     fprintf(stderr, _("-s and -g cannot be used together!\n"));
     exit(1);
   }
-}
-
-/*
- * Locate unicode block that contains given character code.
- * Returns this block or NULL if not found.
- */
-static const struct unicode_block *get_unicode_block(unsigned long charcode) {
-  const struct unicode_block *block;
-
-  for (block = unicode_blocks; block->name; block++) {
-    if ((charcode >= block->start) && (charcode <= block->end))
-      return block;
+  if (output_file_name && !strcmp(output_file_name, "-")
+      && (print_outline || svg_pages_output || split_instances
+          || progress_fd == STDOUT_FILENO)) {
+    fprintf(stderr,
+        _("-l, -P, -X and --progress-fd 1 cannot be used with output to standard output!\n"));
+    exit(1);
   }
-  return NULL;
 }
 
 /*
- * Check if the given character code belongs to the given Unicode block.
+ * Print usage instructions and default values for styles
  */
-static bool is_in_block(unsigned long charcode,
-    const struct unicode_block *block) {
-  return ((charcode >= block->start) && (charcode <= block->end));
-}
+static void usage(const char *cmd) {
+  const char *name, *default_val;
+  unsigned int i;
 
-/*
- * Format and print outline information, if requested by the user.
- */
-static void outline(int level, int page, const char *text) {
-  if (print_outline)
-    printf("%d %d %s\n", level, page, text);
+  fprintf(stderr, _("Usage: %s [ OPTIONS ] -f FONT-FILE -o OUTPUT-FILE\n"
+      "       %s -h\n\n"), cmd, cmd);
+  fprintf(stderr,
+      _("Options:\n"
+          "  --font-file,         -f FONT-FILE    Create samples of FONT-FILE\n"
+          "  --font-index,        -n IDX          Font index in FONT-FILE\n"
+          "  --output-file,       -o OUTPUT-FILE  Save samples to OUTPUT-FILE (- for standard output)\n"
+          "  --help,              -h              Show this information message and exit\n"
+          "  --other-font-file,   -d OTHER-FONT   Compare FONT-FILE with OTHER-FONT and highlight added glyphs\n"
+          "  --other-index,       -m IDX          Font index in OTHER-FONT\n"
+          "  --instances,         -I all|NAME,... Render named instances of a variable font\n"
+          "  --split-instances,   -X              Write every instance to OUTPUT-FILE with its name added\n"
+          "  --diff-glyphs,       -D              Also highlight glyphs that differ from OTHER-FONT\n"
+          "  --report,            -R FORMAT       Print coverage report (json or csv) instead of samples\n"
+          "  --plan,              -M FORMAT       Print the pages (json or csv) instead of rendering them\n"
+          "  --export,            -E FORMAT       Write the contents of the charts as json or html\n"
+          "  --postscript-output, -s              Use PostScript format for output instead of PDF\n"
+          "  --svg,               -g              Use SVG format for output\n"
+          "  --svg-pages,         -P              Write every page to a separate SVG file\n"
+          "  --print-outline,     -l              Print document outlines data to standard output\n"
+          "  --progress-fd,       -p FD           Write progress events as JSON lines to FD\n"
+          "  --trace,             -T TRACE-FILE   Write Chrome trace events of the run to TRACE-FILE\n"
+          "  --include-range,     -i RANGE        Show characters in RANGE\n"
+          "  --exclude-range,     -x RANGE        Do not show characters in RANGE\n"
+          "  --ucd-xml-file,      -r XML_FILE     UCD data in XML_FILE\n"
+          "  --compact[=PERCENT], -c[PERCENT]     Pack characters of blocks covered less than\n"
+          "                                       PERCENT (default 25) into compact tables\n"
+          "  --grid,              -G COLSxROWS    Draw COLS x ROWS cells per page (default 16x16)\n"
+          "  --pages,             -A FIRST-LAST   Draw only pages FIRST to LAST of the document\n"
+          "  --overview[=first],  -O[first]       Draw only a coverage map of every Unicode plane,\n"
+          "                                       or put the maps before the samples\n"
+          "  --style,             -t \"STYLE: VAL\" Set STYLE to value VAL\n"
+          "  --server,            -S SOCKET       Run as a render server listening on SOCKET\n"
+          "  --jobs,              -j N            Run at most N jobs at a time in server mode\n"
+          "  --client,            -C SOCKET       Submit the job to the render server on SOCKET\n"
+          "  --label-font-file,   -L FILE         Use only fonts from FILE for labels and UCD data\n"
+          "  --cache-dir,         -K DIR          Keep character maps and glyph metrics in DIR\n"));
+  fprintf(stderr, _("\nSupported styles (and default values):\n"));
+  for (i = 0; !fntsample_get_style_info(i, &name, &default_val); i++)
+    fprintf(stderr, "\t%s (%s)\n", name, default_val);
 }
 
-/*
- * Draw header of a page.
- * Header shows font name and current Unicode block.
- */
-static void draw_header(cairo_t *cr, const char *face_name,
-    const char *block_name) {
-  PangoLayout *layout;
-  PangoRectangle r;
-
-  layout = layout_text(cr, font_name_font, face_name, &r);
-  cairo_move_to(cr, (A4_WIDTH - (double) r.width / PANGO_SCALE) / 2.0, 30.0);
-  pango_cairo_show_layout_line(cr, pango_layout_get_line_readonly(layout, 0));
-  g_object_unref(layout);
-
-  layout = layout_text(cr, header_font, block_name, &r);
-  cairo_move_to(cr, (A4_WIDTH - (double) r.width / PANGO_SCALE) / 2.0, 50.0);
-  pango_cairo_show_layout_line(cr, pango_layout_get_line_readonly(layout, 0));
-  g_object_unref(layout);
+static void print_outline_entry(void *data, int level, int page,
+    const char *text) {
+  (void) data;
+  printf("%d %d %s\n", level, page, text);
 }
 
 /*
- * Highlight the cell with given coordinates.
- * Used to highlight new glyphs.
+ * Print 's' as a JSON string to the progress stream.
  */
-static void highlight_cell(cairo_t *cr, double x, double y) {
-  cairo_save(cr);
-  cairo_set_source_rgb(cr, 1.0, 1.0, 0.6);
-  cairo_rectangle(cr, x, y, cell_width, cell_height);
-  cairo_fill(cr);
-  cairo_restore(cr);
+static void print_progress_string(const char *s) {
+  putc('"', progress.out);
+  for (; *s; s++) {
+    if (*s == '"' || *s == '\\')
+      fprintf(progress.out, "\\%c", *s);
+    else if ((unsigned char) *s < 0x20)
+      fprintf(progress.out, "\\u%04x", *s);
+    else putc(*s, progress.out);
+  }
+  putc('"', progress.out);
 }
 
 /*
- * Try to place glyph with the given index at the middle of the cell.
- * Changes argument 'glyph'
+ * Write one progress event. Every event is a JSON object on its own line,
+ * flushed immediately so that the reader sees it while rendering goes on.
  */
-static void position_glyph(cairo_t *cr, double x, double y, unsigned long idx,
-    cairo_glyph_t *glyph) {
-  cairo_text_extents_t extents;
-
-  *glyph = (cairo_glyph_t) {idx, 0, 0};
-
-  cairo_glyph_extents(cr, glyph, 1, &extents);
-
-  glyph->x += x + (cell_width - extents.width) / 2.0 - extents.x_bearing;
-  glyph->y += y + glyph_baseline_offset;
+static void print_progress_event(void *data,
+    enum fntsample_progress_event event, int pages, const char *block) {
+  gint64 now = g_get_monotonic_time();
+  double elapsed = (now - progress.start) / 1e6;
+
+  (void) data;
+
+  switch (event) {
+    case FNTSAMPLE_PROGRESS_BLOCK_START:
+      progress.block_start = now;
+      fprintf(progress.out, "{\"event\":\"block_start\",\"block\":");
+      print_progress_string(block);
+      fprintf(progress.out, ",\"pages\":%d,\"elapsed\":%.3f}\n", pages,
+          elapsed);
+      break;
+    case FNTSAMPLE_PROGRESS_BLOCK_END:
+      fprintf(progress.out, "{\"event\":\"block_end\",\"block\":");
+      print_progress_string(block);
+      fprintf(progress.out,
+          ",\"pages\":%d,\"block_seconds\":%.3f,\"elapsed\":%.3f}\n", pages,
+          (now - progress.block_start) / 1e6, elapsed);
+      break;
+    case FNTSAMPLE_PROGRESS_PAGE: {
+      /* The slot holds the finish time of the page RATE_WINDOW pages ago */
+      gint64 *slot = &progress.page_times[pages % RATE_WINDOW];
+      gint64 since = pages > RATE_WINDOW ? *slot : progress.start;
+      int window = MIN(pages, RATE_WINDOW);
+
+      *slot = now;
+      progress.pages = pages;
+      fprintf(progress.out, "{\"event\":\"page\",\"pages\":%d,\"bytes\":%llu,"
+          "\"pages_per_second\":%.2f,\"elapsed\":%.3f}\n", pages, output_bytes,
+          now > since ? window * 1e6 / (now - since) : 0.0, elapsed);
+      break;
+    }
+  }
+  fflush(progress.out);
 }
 
 /*
- * Draw table grid with row and column numbers.
+ * Start writing progress events to the descriptor given by --progress-fd.
  */
-static void draw_grid(cairo_t *cr, unsigned int x_cells,
-    unsigned long block_start) {
-  unsigned int i;
-  double x_min = (A4_WIDTH - x_cells * cell_width) / 2;
-  double x_max = (A4_WIDTH + x_cells * cell_width) / 2;
-  char buf[9];
-  PangoLayout *layout;
-  PangoRectangle r;
-
-#define TABLE_H (A4_HEIGHT - ymin_border * 2)
-  cairo_set_line_width(cr, 1.0);
-  cairo_rectangle(cr, x_min, ymin_border, x_max - x_min, TABLE_H);
-  cairo_move_to(cr, x_min, ymin_border);
-  cairo_line_to(cr, x_min, ymin_border - 15.0);
-  cairo_move_to(cr, x_max, ymin_border);
-  cairo_line_to(cr, x_max, ymin_border - 15.0);
-  cairo_stroke(cr);
-
-  cairo_set_line_width(cr, 0.5);
-  /* draw horizontal lines */
-  for (i = 1; i < 16; i++) {
-    cairo_move_to(cr, x_min, 72.0 + i * TABLE_H / 16);
-    cairo_line_to(cr, x_max, 72.0 + i * TABLE_H / 16);
-  }
-
-  /* draw vertical lines */
-  for (i = 1; i < x_cells; i++) {
-    cairo_move_to(cr, x_min + i * cell_width, ymin_border);
-    cairo_line_to(cr, x_min + i * cell_width, A4_HEIGHT - ymin_border);
-  }
-  cairo_stroke(cr);
-
-  /* draw glyph numbers */
-  buf[1] = '\0';
-#define hexdigs	"0123456789ABCDEF"
-
-  for (i = 0; i < 16; i++) {
-    buf[0] = hexdigs[i];
-    layout = layout_text(cr, table_numbers_font, buf, &r);
-    cairo_move_to(cr, x_min - (double) PANGO_RBEARING(r) / PANGO_SCALE - 5.0,
-        72.0 + (i + 0.5) * TABLE_H / 16
-            + (double) PANGO_DESCENT(r) / PANGO_SCALE / 2);
-    pango_cairo_show_layout_line(cr, pango_layout_get_line_readonly(layout, 0));
-    cairo_move_to(cr, x_min + x_cells * cell_width + 5.0,
-        72.0 + (i + 0.5) * TABLE_H / 16
-            + (double) PANGO_DESCENT(r) / PANGO_SCALE / 2);
-    pango_cairo_show_layout_line(cr, pango_layout_get_line_readonly(layout, 0));
-    g_object_unref(layout);
+static void start_progress(const char *prog) {
+  if (progress_fd == STDOUT_FILENO)
+    progress.out = stdout;
+  else if (progress_fd == STDERR_FILENO)
+    progress.out = stderr;
+  else progress.out = fdopen(progress_fd, "w");
+
+  if (!progress.out) {
+    fprintf(stderr, "%s: --progress-fd: ", prog);
+    perror(NULL);
+    exit(1);
   }
 
-  for (i = 0; i < x_cells; i++) {
-    snprintf(buf, sizeof(buf), "%03lX", block_start / 16 + i);
-    layout = layout_text(cr, table_numbers_font, buf, &r);
-    cairo_move_to(cr,
-        x_min + i * cell_width
-            + (cell_width - (double) r.width / PANGO_SCALE) / 2,
-        ymin_border - 5.0);
-    pango_cairo_show_layout_line(cr, pango_layout_get_line_readonly(layout, 0));
-    g_object_unref(layout);
-  }
+  progress.start = g_get_monotonic_time();
+  fntsample_set_progress_func(ctx, print_progress_event, NULL);
 }
 
-/*
- * Fill empty cell. Color of the fill depends on the character properties.
- */
-static void fill_empty_cell(cairo_t *cr, double x, double y,
-    unsigned long charcode) {
-  cairo_save(cr);
-  if (g_unichar_isdefined(charcode)) {
-    if (g_unichar_iscntrl(charcode))
-      cairo_set_source_rgb(cr, 0.0, 0.0, 0.5);
-    else cairo_set_source_rgb(cr, 0.5, 0.5, 0.5);
-  }
-  cairo_rectangle(cr, x, y, cell_width, cell_height);
-  cairo_fill(cr);
-  cairo_restore(cr);
+static void finish_progress(int status) {
+  fprintf(progress.out, "{\"event\":\"done\",\"status\":%d,\"pages\":%d,"
+      "\"bytes\":%llu,\"elapsed\":%.3f}\n", status, progress.pages, output_bytes,
+      (g_get_monotonic_time() - progress.start) / 1e6);
+  fflush(progress.out);
 }
 
 /*
- * Draw label with character code.
+ * Cairo write function of the output surfaces, counts written bytes.
  */
-static void draw_charcode(cairo_t *cr, double x, double y, FT_ULong charcode) {
-  char buf[9];
-  PangoLayout *layout;
-  PangoRectangle r;
-
-  snprintf(buf, sizeof(buf), "%04lX", charcode);
-  layout = layout_text(cr, cell_numbers_font, buf, &r);
-  cairo_move_to(cr, x + (cell_width - (double) r.width / PANGO_SCALE) / 2.0,
-      y + cell_height - cell_label_offset);
-  pango_cairo_show_layout_line(cr, pango_layout_get_line_readonly(layout, 0));
-  g_object_unref(layout);
+static cairo_status_t write_output(void *closure, const unsigned char *data,
+    unsigned int length) {
+  (void) closure;
+
+  if (stream_writer_write(output, data, length))
+    return CAIRO_STATUS_WRITE_ERROR;
+  output_bytes += length;
+  return CAIRO_STATUS_SUCCESS;
 }
 
 /*
- * Draws tables for all characters in the given Unicode block.
- * Use font described by face and ft_face. Start from character
- * with given charcode (it should belong to the given Unicode
- * block). After return 'charcode' equals the last character code
- * of the block.
- *
- * Returns number of pages drawn.
+ * Write the coverage report, the page plan or the exported contents to the
+ * output file, or to standard output if no output file was given.
  */
-static int draw_unicode_block(cairo_t *cr, cairo_scaled_font_t *font,
-    FT_Face ft_face, const char *fontname, unsigned long *charcode,
-    const struct unicode_block *block, FT_Face ft_other_face) {
-  FT_UInt idx;
-  unsigned long prev_charcode;
-  unsigned long prev_cell;
-  int npages = 0;
-
-  idx = FT_Get_Char_Index(ft_face, *charcode);
-
-  do {
-    unsigned long offset = ((*charcode - block->start) / 0x100) * 0x100;
-    unsigned long tbl_start = block->start + offset;
-    unsigned long tbl_end =
-        tbl_start + 0xFF > block->end ? block->end + 1 : tbl_start + 0x100;
-    unsigned int rows = (tbl_end - tbl_start) / 16;
-    double x_min = (A4_WIDTH - rows * cell_width) / 2;
-    unsigned long i;
-    bool filled_cells[256]; /* 16x16 glyphs max */
-
-    /* XXX WARNING: not reentrant! */
-    static cairo_glyph_t glyphs[256];
-    unsigned int nglyphs = 0;
-
-    cairo_save(cr);
-    draw_header(cr, fontname, block->name);
-    prev_cell = tbl_start - 1;
-
-    memset(filled_cells, '\0', sizeof(filled_cells));
-
-    cairo_set_scaled_font(cr, font);
-    /*
-     * Fill empty cells and calculate coordinates of the glyphs.
-     * Also highlight cells if needed.
-     */
-    do {
-      /* the current glyph position in the table */
-      int charpos = *charcode - tbl_start;
-
-      /* fill empty cells before the current glyph */
-      for (i = prev_cell + 1; i < *charcode; i++) {
-        int pos = i - tbl_start;
-        fill_empty_cell(cr, CELL_X(x_min, pos), CELL_Y(pos), i);
-      }
-
-      /* if it is new glyph - highlight the cell */
-      if (ft_other_face && !FT_Get_Char_Index(ft_other_face, *charcode))
-        highlight_cell(cr, CELL_X(x_min, charpos), CELL_Y(charpos));
-
-      /* For now just position glyphs. They will be shown later,
-       * to make output more efficient. */
-      position_glyph(cr, CELL_X(x_min, charpos), CELL_Y(charpos), idx,
-          &glyphs[nglyphs++]);
-
-      filled_cells[charpos] = true;
-
-      prev_charcode = *charcode;
-
-      prev_cell = *charcode;
-      *charcode = get_next_char(ft_face, *charcode, &idx);
-    } while (idx && (*charcode < tbl_end) && is_in_block(*charcode, block));
-
-    /* Fill remaining empty cells */
-    for (i = prev_cell + 1; i < tbl_end; i++) {
-      int pos = i - tbl_start;
-      fill_empty_cell(cr, CELL_X(x_min, pos), CELL_Y(pos), i);
+static int write_report(const char *prog) {
+  FILE *out = stdout;
+  int status;
+
+  if (output_file_name && strcmp(output_file_name, "-")) {
+    out = fopen(output_file_name, "w");
+    if (!out) {
+      fprintf(stderr, "%s: ", prog);
+      perror(output_file_name);
+      exit(1);
     }
-
-    /* Show previously positioned glyphs */
-    cairo_show_glyphs(cr, glyphs, nglyphs);
-
-    for (i = 0; i < tbl_end - tbl_start; i++)
-      if (filled_cells[i])
-        draw_charcode(cr, CELL_X(x_min, i), CELL_Y(i), i + tbl_start);
-
-    draw_grid(cr, rows, tbl_start);
-    npages++;
-    cairo_show_page(cr);
-    cairo_restore(cr);
-  } while (idx && is_in_block(*charcode, block));
-
-  *charcode = prev_charcode;
-  return npages;
-}
-
-/* =================================================================================== */
-/* Draw UCD comments.
- *
- * Author: Paweł Parafiński <ppablo28@gmail.com>
- * This is an extension of the project available at: http://sourceforge.net/projects/fntsample/?source=dlp
- * In this version UCD comments are drawn after each block.
- */
-/* =================================================================================== */
-
-#define BLOCK_HEADER_X(hWidth)  (A4_WIDTH - hWidth / PANGO_SCALE) / 2.0
-#define BLOCK_HEADER_Y  30.0
-#define COLUMN_WIDTH    A4_WIDTH / 2.0
-#define MAX_COLUMN_Y    A4_HEIGHT - ymin_border
-#define BASE_Y          BLOCK_HEADER_Y + 10.0
-#define OFFSET_BASE     10.0
-#define OFFSET_SPACE    5.0
-#define COORD_X(factor) xmin_border + OFFSET_BASE + factor * (COLUMN_WIDTH - xmin_border - OFFSET_BASE)
-#define WRAP_LIMIT(val) (COLUMN_WIDTH - val) * PANGO_SCALE
-#define RES_FACTOR      96.0 / 72.0
-
-/* UTF-8 chars to distinguish different UCD data */
-const unsigned char rightwards_arrow[] = { 0xE2, 0x86, 0x92, 0x0 };
-const unsigned char bullet[] = { 0xE2, 0x80, 0xA2, 0x0 };
-const unsigned char equal_sign[] = { 0x3D, 0x0 };
-const unsigned char asterisk[] = { 0x2A, 0x0 };
-const unsigned char reference_mark[] = { 0xE2, 0x80, 0xBB, 0x0 };
-const unsigned char approx[] = { 0xE2, 0x89, 0x88, 0x0 };
-const unsigned char equiv[] = { 0xE2, 0x89, 0xA1, 0x0 };
-const unsigned char tilde[] = { 0x7E, 0x0 };
-const unsigned char less_than[] = { 0x3C, 0x0 };
-const unsigned char greater_than[] = { 0x3E, 0x0 };
-
-/* The root of the block headers */
-static struct header_block *ucd_blocks = NULL;
-
-/* A set of fonts for drawing UCD data */
-static PangoFontDescription *notice_line_font;
-static PangoFontDescription *block_header_font;
-static PangoFontDescription *subheader_font;
-static PangoFontDescription *other_font;
-
-struct ucd_style {
-  const char * const name;
-  const char * const style;
-};
-
-static struct ucd_style ucd_styles[] = { { "notice_line", "Sans Italic 6" }, {
-    "block_header", "Sans Bold 11" }, { "block_subheader", "Sans Bold 9" }, {
-    "other", "Serif 7" }, { NULL, NULL } };
-
-static const char const *get_ucd_style(const char *name) {
-  struct ucd_style *style = ucd_styles;
-
-  for (; style->name; style++) {
-    if (!strcmp(name, style->name))
-      return style->style;
   }
 
-  return NULL;
-}
-
-/* Initialize all fonts needed for generating UCD comments */
-static void init_ucd_fonts(void) {
-  block_header_font = pango_font_description_from_string(
-      get_ucd_style("block_header"));
-  subheader_font = pango_font_description_from_string(
-      get_ucd_style("block_subheader"));
-  notice_line_font = pango_font_description_from_string(
-      get_ucd_style("notice_line"));
-  other_font = pango_font_description_from_string(get_ucd_style("other"));
-}
-
-/* Get the height of the given layout and delete it */
-static double get_pango_layout_height_and_free(PangoLayout *layout) {
-  int height;
-  pango_layout_get_size(layout, NULL, &height);
-  g_object_unref(layout);
-  return (double) height / PANGO_SCALE;
-}
-
-/* Get the width of the given layout and delete it */
-static double get_pango_layout_width_and_free(PangoLayout *layout) {
-  int width;
-  pango_layout_get_size(layout, &width, NULL);
-  g_object_unref(layout);
-  return (double) width / PANGO_SCALE;
-}
+  if (export_format)
+    status = fntsample_export(ctx,
+        strcmp(export_format, "html") ? FNTSAMPLE_EXPORT_JSON : FNTSAMPLE_EXPORT_HTML,
+        out);
+  else if (plan_format)
+    status = fntsample_plan(ctx,
+        strcmp(plan_format, "csv") ? FNTSAMPLE_REPORT_JSON : FNTSAMPLE_REPORT_CSV,
+        out);
+  else status = fntsample_report(ctx,
+      strcmp(report_format, "csv") ? FNTSAMPLE_REPORT_JSON : FNTSAMPLE_REPORT_CSV,
+      out);
 
-/* Draw basic text in the layout with the given font and wrap it (optional) */
-static PangoLayout *draw_ucd_text(cairo_t *cr, const char *text,
-    PangoFontDescription *font, int wrap_width) {
-  PangoLayout *layout = layout_text(cr, font, text, NULL);
-  pango_layout_set_width(layout,
-      wrap_width != -1.0 ? WRAP_LIMIT(wrap_width) : -1.0);
-  pango_layout_set_wrap(layout, PANGO_WRAP_WORD);
-  pango_cairo_show_layout(cr, layout);
-  return layout;
+  if (out != stdout && fclose(out)) {
+    perror(output_file_name);
+    return 1;
+  }
+  return status;
 }
 
 /*
- * Draw header of the UCD block.
+ * Render every page to FILE-NNNN.svg, with glyphs shared in
+ * FILE-glyphs.svg. The .svg extension of 'file_name' is dropped.
  */
-static PangoLayout *draw_ucd_block_header(cairo_t *cr, const char *block_header_name) {
-  PangoLayout *layout;
-  PangoRectangle r;
-
-  layout = layout_text(cr, block_header_font, block_header_name, &r);
-  cairo_move_to(cr, BLOCK_HEADER_X((double) r.width), BLOCK_HEADER_Y);
-  pango_cairo_show_layout(cr, layout);
-  return layout;
-}
+static int write_svg_pages(const char *file_name) {
+  size_t len = strlen(file_name);
+  char *base_name = strdup(file_name);
+  int status;
 
-/* Draw single UCD char code using given font and coordinates */
-static PangoLayout *draw_ucd_charcode(cairo_t *cr, PangoFontDescription *font,
-    FT_ULong charcode, double x, double y) {
-  char code[8];
+  if (!base_name) {
+    perror("strdup");
+    exit(1);
+  }
 
-  /* Draw the char code (fill with '0' if less than 4 signs) */
-  cairo_move_to(cr, x, y);
-  sprintf(code, "%04lX", charcode);
-  return draw_ucd_text(cr, code, font, -1.0);
-}
+  if (len > 4 && !strcmp(base_name + len - 4, ".svg"))
+    base_name[len - 4] = '\0';
 
-/* Draw the first and the last character code drawn at the current page */
-static void draw_ucd_char_limits(cairo_t *cr, FT_ULong leftLimit,
-    FT_ULong rightLimit) {
-  PangoLayout *layout;
-  double width;
-
-  /* Draw left char code and get its width */
-  layout = draw_ucd_charcode(cr, block_header_font, leftLimit, xmin_border,
-      BLOCK_HEADER_Y);
-  width = get_pango_layout_width_and_free(layout);
-
-  /* Draw right char code */
-  layout =
-      draw_ucd_charcode(cr, block_header_font, rightLimit,
-          A4_WIDTH - xmin_border - width, BLOCK_HEADER_Y);
-  g_object_unref(layout);
+  status = fntsample_render_svg_pages(ctx, base_name);
+  free(base_name);
+  return status;
 }
 
 /*
- * Draw properties of character entries, subheaders or blocks
+ * Render samples to 'file_name' ("-" for standard output). If 'n' is not
+ * 0, the named instances 'instances' of the font are rendered one after
+ * another.
  */
-static PangoLayout *draw_ucd_tag(cairo_t *cr,
-    const struct simple_tag * const tag, double x, double y, double offset) {
-  PangoLayout *layout = NULL;
-  double width;
-
-  /* Move to the proper place */
-  cairo_move_to(cr, x, y);
-
-  /* NOTICE LINE */
-  if (strcmp(tag->name, xmlTags.NOTICE_LINE) == 0) {
-    char *text = NULL;
-
-    /* If the notice line has any additional attributes - check them */
-    if (tag->info) {
-      struct tag_attr *attr = tag->info;
-      for (; attr; attr = attr->next) {
-        if (strcmp(attr->name, xmlAttrs.WITH_ASTERISK) == 0) {
-          text = malloc(snprintf(NULL, 0, "%s %s", asterisk, tag->content) + 1);
-          sprintf(text, "%s %s", asterisk, tag->content);
-        }
-      }
-    }
-
-    /* Draw text, free memory if needed */
-    if (text) {
-      layout = draw_ucd_text(cr, text, notice_line_font,
-          xmin_border + OFFSET_BASE);
-      free(text);
-    }
-    else {
-      layout = draw_ucd_text(cr, tag->content, notice_line_font,
-          xmin_border + OFFSET_BASE);
-    }
-
-    return layout;
+static int write_samples(const char *prog, const char *file_name,
+    const int *instances, int n) {
+  cairo_surface_t *surface;
+  cairo_status_t cr_status;
+  int64_t start;
+  int fd, status, err;
+
+  if (!strcmp(file_name, "-"))
+    fd = STDOUT_FILENO;
+  else fd = open(file_name, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+  if (fd == -1) {
+    fprintf(stderr, "%s: ", prog);
+    perror(file_name);
+    exit(1);
   }
 
-  /* At first draw a sign, then draw the content (take care of the sign width) */
-
-  /* COMMENT LINE */
-  if (strcmp(tag->name, xmlTags.COMMENT_LINE) == 0) {
-    char *text = malloc(snprintf(NULL, 0, "%s ", bullet) + 1);
-    sprintf(text, "%s ", bullet);
-    layout = draw_ucd_text(cr, text, other_font, -1.0);
-    free(text);
+  output = stream_writer_new(fd, OUTPUT_BUFFER_SIZE);
+  if (!output) {
+    perror("malloc");
+    exit(1);
   }
 
-  /* ALIAS LINE */
-  if (strcmp(tag->name, xmlTags.ALIAS_LINE) == 0) {
-    char *text = malloc(snprintf(NULL, 0, "%s ", equal_sign) + 1);
-    sprintf(text, "%s ", equal_sign);
-    layout = draw_ucd_text(cr, text, other_font, -1.0);
-    free(text);
-  }
+  if (postscript_output)
+    surface = cairo_ps_surface_create_for_stream(write_output, NULL,
+        FNTSAMPLE_PAGE_WIDTH, FNTSAMPLE_PAGE_HEIGHT);
+  else if (svg_output)
+    surface = cairo_svg_surface_create_for_stream(write_output, NULL,
+        FNTSAMPLE_PAGE_WIDTH, FNTSAMPLE_PAGE_HEIGHT);
+  else surface = cairo_pdf_surface_create_for_stream(write_output, NULL,
+      FNTSAMPLE_PAGE_WIDTH, FNTSAMPLE_PAGE_HEIGHT);
 
-  /* CROSS REF */
-  if (strcmp(tag->name, xmlTags.CROSS_REF) == 0) {
-    char *text = malloc(snprintf(NULL, 0, "%s ", rightwards_arrow) + 1);
-    sprintf(text, "%s ", rightwards_arrow);
-    layout = draw_ucd_text(cr, text, other_font, -1.0);
-    free(text);
+  cr_status = cairo_surface_status(surface);
+  if (cr_status != CAIRO_STATUS_SUCCESS) {
+    /* TRANSLATORS: 'cairo' is a name of a library, and should be left untranslated */
+    fprintf(stderr, _("%s: failed to create cairo surface: %s\n"), prog,
+        cairo_status_to_string(cr_status));
+    exit(1);
   }
 
-  /* COMPAT MAPPING */
-  if (strcmp(tag->name, xmlTags.COMPAT_MAPPING) == 0) {
-    char *text = malloc(snprintf(NULL, 0, "%s ", approx) + 1);
-    sprintf(text, "%s ", approx);
-    layout = draw_ucd_text(cr, text, other_font, -1.0);
-    free(text);
-  }
+  if (n)
+    status = fntsample_render_instances(ctx, surface, instances, n);
+  else status = fntsample_render(ctx, surface);
 
-  /* VARIATION LINE */
-  if (strcmp(tag->name, xmlTags.VARIATION_LINE) == 0) {
-    char *text = malloc(snprintf(NULL, 0, "%s ", tilde) + 1);
-    sprintf(text, "%s ", tilde);
-    layout = draw_ucd_text(cr, text, other_font, -1.0);
-    free(text);
+  /* Destroying the surface writes the rest of the document */
+  start = fntsample_trace_begin();
+  cairo_surface_destroy(surface);
+  /* The file is closed even if writing failed, the first error is reported */
+  err = stream_writer_close(output) ? errno : 0;
+  if (fd != STDOUT_FILENO && close(fd) && !err)
+    err = errno;
+  if (err && !status) {
+    errno = err;
+    perror(file_name);
+    status = 1;
   }
+  fntsample_trace_end("finish surface", start);
+  return status;
+}
 
-  /* DECOMPOSITION */
-  if (strcmp(tag->name, xmlTags.DECOMPOSITION) == 0) {
-    char *text = malloc(snprintf(NULL, 0, "%s ", equiv) + 1);
-    sprintf(text, "%s ", equiv);
-    layout = draw_ucd_text(cr, text, other_font, -1.0);
-    free(text);
-  }
+/*
+ * Find the instance 'name' of the font, exits if there is no such one.
+ */
+static int find_instance(const char *prog, const char *name) {
+  char *s;
+  int i;
 
-  /* FORMAL ALIAS LINE */
-  if (strcmp(tag->name, xmlTags.FORMALALIAS_LINE) == 0) {
-    char *text = malloc(snprintf(NULL, 0, "%s ", reference_mark) + 1);
-    sprintf(text, "%s ", reference_mark);
-    layout = draw_ucd_text(cr, text, other_font, -1.0);
-    free(text);
-  }
+  for (i = 1; (s = fntsample_get_instance_name(ctx, i)); i++) {
+    bool found = !g_ascii_strcasecmp(s, name);
 
-  width = get_pango_layout_width_and_free(layout);
-  cairo_move_to(cr, x + width, y);
-  layout = draw_ucd_text(cr, tag->content, other_font,
-      xmin_border + OFFSET_BASE + offset + width);
+    free(s);
+    if (found)
+      return i;
+  }
 
-  return layout;
+  fprintf(stderr, _("%s: %s has no instance named %s\n"), prog,
+      font_file_name, name);
+  exit(1);
 }
 
 /*
- * Check if the current 'y' coordinate is correct (in the text drawing area). If not
- * change the column, where the text is drawn (optionally create new page). Draw the first
- * and the last char together with page change. Draw current block header as the first
- * element of the new page. Reset 'y' coordinate and update column  current indicator.
+ * Get the instances given by --instances, 'all' or a list of names
+ * separated by commas. Sets 'n' to the number of instances.
  */
-static void check_and_update_coords(cairo_t *cr, double *factor, double *coordY,
-    const struct header_block *block, FT_ULong *firstChar, FT_ULong *lastChar) {
-  /* If the max coordinate for a column encountered show new page and update proper values */
-  if (*coordY >= MAX_COLUMN_Y) {
-    if (*factor == 1.0) {
-      /* Draw code points of the first and the last character drawn at this page */
-      if (*firstChar != -1UL && *lastChar != -1UL) {
-        draw_ucd_char_limits(cr, *firstChar, *lastChar);
-        *firstChar = -1UL, *lastChar = -1UL;
-      }
-
-      /* Show the next page */
-      cairo_show_page(cr);
+static int *select_instances(const char *prog, int *n) {
+  int *instances = NULL;
+  char *names, *name, *saveptr;
+
+  *n = 0;
+  if (!strcmp(instances_spec, "all")) {
+    int count = 0;
+    char *s;
+
+    while ((s = fntsample_get_instance_name(ctx, count + 1))) {
+      free(s);
+      count++;
+    }
+    if (!count) {
+      fprintf(stderr, _("%s: %s has no named instances\n"), prog,
+          font_file_name);
+      exit(1);
     }
 
-    /* Update the factor and y coordinate */
-    *factor = abs(*factor - 1.0);
-    *coordY = BASE_Y;
+    instances = malloc(sizeof(*instances) * count);
+    if (!instances) {
+      perror("malloc");
+      exit(1);
+    }
+    for (; *n < count; (*n)++)
+      instances[*n] = *n + 1;
+    return instances;
   }
 
-  /* If new page has been drawn show header and limits */
-  if (*coordY == BASE_Y) {
-    /* If new page added - draw the header's name and code points limits */
-    double height = get_pango_layout_height_and_free(
-        draw_ucd_block_header(cr, block->name));
-
-    /* Update the y coordinate */
-    *coordY += height;
+  /* There cannot be more names than characters */
+  names = strdup(instances_spec);
+  instances = malloc(sizeof(*instances) * (strlen(instances_spec) + 1));
+  if (!names || !instances) {
+    perror("malloc");
+    exit(1);
   }
-}
 
-/* Draw simple tags (notice lines, cross references, etc.). Update all variables during drawing.
- *
- * Parameters:
- *   multFactor - whether draw the text in the first column (0.0) or in the second one (1.0)
- *   x - the offset of the x coordinate
- *   y - the y coordinate
- *   first - the first drawn character at this page
- *   last - the last drawn character at this page
- *   bl - the header block (the current one)
- */
-static void draw_ucd_simple_tags(cairo_t *cr, struct simple_tag *tags,
-    double *multFactor, double x, double *y, FT_ULong *first, FT_ULong *last,
-    const struct header_block *bl) {
-  PangoLayout *layout;
-  const struct simple_tag *smpl_tags;
-
-  for (smpl_tags = tags; smpl_tags; smpl_tags = smpl_tags->next) {
-    check_and_update_coords(cr, multFactor, y, bl, first, last);
-    layout = draw_ucd_tag(cr, smpl_tags, COORD_X(*multFactor) + x, *y, x);
-    if (layout != NULL) {
-      *y += get_pango_layout_height_and_free(layout);
-    }
-  }
+  for (name = strtok_r(names, ",", &saveptr); name;
+      name = strtok_r(NULL, ",", &saveptr))
+    instances[(*n)++] = find_instance(prog, name);
+
+  free(names);
+  return instances;
 }
 
-/* Draw a char entry (code point, char, name)
- *
- * Parameters:
- *   multFactor - whether draw the text in the first column (0.0) or in the second one (1.0)
- *   y - the y coordinate
- *   first - the first drawn character at this page
- *   last - the last drawn character at this page
- *   block - the header block (the current one)
+/*
+ * Insert the instance name before the extension of 'file_name':
+ * out.pdf becomes out-Bold.pdf. Spaces in the name are dropped.
  */
-static void draw_ucd_char_entry(cairo_t *cr, FT_Face ft_face,
-    cairo_scaled_font_t *font, const struct char_entry *entry,
-    double *multFactor, double *width, double *coordY, FT_ULong *first,
-    FT_ULong *last, const struct header_block *block) {
-  PangoLayout *layout;
-  double temp_width, text_height;
-  int tempH;
-  FT_UInt idx = FT_Get_Char_Index(ft_face, (FT_ULong) entry->cp);
-  cairo_glyph_t glyphs[1];
-  cairo_matrix_t matrix;
-  cairo_font_extents_t extents;
-
-  // Draw charcode
-  check_and_update_coords(cr, multFactor, coordY, block, first, last);
-  layout = draw_ucd_charcode(cr, other_font, entry->cp, COORD_X(*multFactor),
-      *coordY);
-
-  // Get the height of the comments' text
-  pango_layout_get_size(layout, NULL, &tempH);
-  text_height = ((double) tempH) / PANGO_SCALE;
-  text_height = text_height * RES_FACTOR;
-  // Get the width and release the layout
-  temp_width = get_pango_layout_width_and_free(layout);
-
-  if (entry->name) {
-    cairo_save(cr);
-    cairo_set_scaled_font(cr, font);
-    cairo_get_font_matrix(cr, &matrix);
-    cairo_font_extents(cr, &extents);
-    cairo_matrix_scale(&matrix, text_height / extents.height,
-        text_height / extents.height);
-    cairo_set_font_matrix(cr, &matrix);
-
-    /* Try to draw sign */
-    glyphs[0] =
-        (cairo_glyph_t) {idx, COORD_X(*multFactor) + OFFSET_SPACE + temp_width, *coordY + text_height / 2.0};
-    cairo_show_glyphs(cr, glyphs, 1);
-    *width = 2.0 * OFFSET_SPACE + temp_width;
-
-    // Show the name of the char
-    cairo_move_to(cr, COORD_X(*multFactor) + OFFSET_SPACE + *width, *coordY);
-    layout = draw_ucd_text(cr, entry->name, other_font,
-        xmin_border + OFFSET_BASE);
-    *width = 2.0 * OFFSET_SPACE + *width;
-    cairo_restore(cr);
-  }
-  else {
-    *width = temp_width;
-    cairo_move_to(cr, COORD_X(*multFactor) + OFFSET_SPACE + *width, *coordY);
-    char *text = malloc(
-        snprintf(NULL, 0, "%s%s%s", less_than, entry->type, greater_than) + 1);
-    sprintf(text, "%s%s%s", less_than, entry->type, greater_than);
-    layout = draw_ucd_text(cr, text, other_font,
-        xmin_border + OFFSET_BASE + OFFSET_SPACE);
-    *width = OFFSET_SPACE + *width;
-    free(text);
+static char *instance_file_name(const char *file_name, const char *name) {
+  const char *slash = strrchr(file_name, '/');
+  const char *dot = strrchr(slash ? slash : file_name, '.');
+  size_t base_len = dot ? (size_t) (dot - file_name) : strlen(file_name);
+  char *s = malloc(strlen(file_name) + strlen(name) + 2);
+  char *p;
+
+  if (!s) {
+    perror("malloc");
+    exit(1);
   }
-  *coordY += get_pango_layout_height_and_free(layout);
-}
 
-static int glyphs_can_be_drawn(FT_Face ft_face, struct char_entry *entry) {
-  struct char_entry *temp = entry;
-  for (; temp; temp = temp->next) {
-    if ((FT_Get_Char_Index(ft_face, (FT_ULong) temp->cp) && temp->name) || !temp->name) {
-      return 0;
-    }
+  memcpy(s, file_name, base_len);
+  p = s + base_len;
+  *p++ = '-';
+  for (; *name; name++) {
+    if (*name != ' ')
+      *p++ = *name;
   }
-  return 1;
+  strcpy(p, file_name + base_len);
+  return s;
 }
 
 /*
- * The main function of drawing UCD comments. It takes the character code and depending
- * on the value chooses the actual block header.
+ * Render the instances selected with --instances, to one document or,
+ * with --split-instances (always for SVG pages), to a file per instance.
  */
-static void draw_ucd_data(cairo_t *cr, FT_Face ft_face,
-    cairo_scaled_font_t *font, const FT_ULong charcode) {
-  PangoLayout *layout;
-  double height = 0.0, width = 0.0;
-  double multFactor = 0.0; /* Draw text in the first column (0.0) or the second one (1.0) */
-  double coordY = BASE_Y; /* Coordinate Y */
-
-  /* The first and the last drawn character code */
-  FT_ULong drawnFirst = -1UL;
-  FT_ULong drawnLast = -1UL;
-
-  /* Get the block containing the given character */
-  const struct header_block *block = find_ucd_block(ucd_blocks, charcode);
-  const struct subheader_block *sub_block;
-  const struct char_entry *entry;
-
-  if (block) {
-    /* Draw all tags connected with this block header (notice lines, cross references, etc.) */
-    draw_ucd_simple_tags(cr, block->outer_tags, &multFactor, 0.0, &coordY,
-        &drawnFirst, &drawnLast, block);
-
-    for (sub_block = block->subheaders; sub_block; sub_block =
-        sub_block->next) {
-      /* Do not draw comment if not in range */
-      if ((!in_range(sub_block->start) && !in_range(sub_block->end)) || glyphs_can_be_drawn(ft_face, sub_block->chars) == 1)
-        continue;
-
-      /* Draw subheader name and update the 'y' coordinate */
-      check_and_update_coords(cr, &multFactor, &coordY, block, &drawnFirst,
-          &drawnLast);
-      cairo_move_to(cr, COORD_X(multFactor), coordY);
-      layout = draw_ucd_text(cr, sub_block->name, subheader_font,
-          xmin_border + OFFSET_BASE);
-      height = get_pango_layout_height_and_free(layout);
-      coordY += height + 1.0;
-
-      /* Draw all tags connected with this subheader (notice lines, cross references, etc.) */
-      draw_ucd_simple_tags(cr, sub_block->outer_tags, &multFactor, 0.0, &coordY,
-          &drawnFirst, &drawnLast, block);
-
-      /* Draw all char entries from this block */
-      for (entry = sub_block->chars; entry; entry = entry->next) {
-        /* Do not draw comment if not in range */
-        if (!in_range(entry->cp) || (!FT_Get_Char_Index(ft_face, (FT_ULong) entry->cp) && entry->name))
-          continue;
-
-        draw_ucd_char_entry(cr, ft_face, font, entry, &multFactor, &width,
-            &coordY, &drawnFirst, &drawnLast, block);
-
-        /* Update values of the first char (only at the beginning) and the last one (always) */
-        if (drawnFirst == -1UL) {
-          drawnFirst = entry->cp;
-        }
-        drawnLast = entry->cp;
+static int write_instances(const char *prog) {
+  int *instances, n, i, status = 0;
 
-        /* Draw all information connected with this char entry */
-        draw_ucd_simple_tags(cr, entry->char_info, &multFactor, width, &coordY,
-            &drawnFirst, &drawnLast, block);
-      }
-    }
-    /* Drawing ended before creating a new page */
-    draw_ucd_char_limits(cr, drawnFirst, drawnLast);
+  instances = select_instances(prog, &n);
 
-    /* Drawing ended - show new page */
-    cairo_show_page(cr);
+  if (!split_instances && !svg_pages_output)
+    status = write_samples(prog, output_file_name, instances, n);
+  else {
+    for (i = 0; i < n && !status; i++) {
+      char *name = fntsample_get_instance_name(ctx, instances[i]);
+      char *file_name = instance_file_name(output_file_name, name);
+
+      fntsample_set_instance(ctx, instances[i]);
+      if (svg_pages_output)
+        status = write_svg_pages(file_name);
+      else status = write_samples(prog, file_name, NULL, 0);
+      free(file_name);
+      free(name);
+    }
+    fntsample_set_instance(ctx, 0);
   }
+
+  free(instances);
+  return status;
 }
 
 /*
- * The main drawing function.
+ * Render samples of the font given by the options to the output file.
  */
-static void draw_glyphs(cairo_t *cr, cairo_scaled_font_t *font, FT_Face ft_face,
-    const char *fontname, FT_Face ft_other_face) {
-  FT_ULong charcode;
-  FT_UInt idx;
-  const struct unicode_block *block;
-  int pageno = 1;
-
-  /* Prepare to drawing comments if program argument's been specified */
-  if (xml_file_name) {
-    xmlDoc *doc = NULL;
-    xmlNode *root_element = NULL;
-
-    LIBXML_TEST_VERSION
-
-    /* Parse the file and get the DOM */
-    doc = xmlReadFile(xml_file_name, NULL, 0);
-    if (doc == NULL) {
-      printf("error: could not parse file %s\n", xml_file_name);
-    }
-
-    /*Get the root element node, parse and free the whole structure */
-    root_element = xmlDocGetRootElement(doc);
-    ucd_blocks = parse_ucd_from_xml(root_element->children);
-    xmlFreeDoc(doc);
+static int render_samples(const char *prog) {
+  int status;
 
-    /* Initialize necessary fonts */
-    init_ucd_fonts();
+  if (fntsample_set_font(ctx, font_file_name, font_index)
+      || (other_font_file_name
+          && fntsample_set_other_font(ctx, other_font_file_name, other_index))) {
+    perror("malloc");
+    exit(1);
   }
 
-  outline(0, pageno, fontname);
+  /* A broken UCD file is not fatal, samples are drawn without comments */
+  if (xml_file_name)
+    fntsample_load_ucd_xml(ctx, xml_file_name);
 
-  charcode = get_first_char(ft_face, &idx);
+  if (report_format || plan_format || export_format)
+    return write_report(prog);
 
-  while (idx) {
-    block = get_unicode_block(charcode);
-    if (block) {
-      int npages;
-      outline(1, pageno, block->name);
-      npages = draw_unicode_block(cr, font, ft_face, fontname, &charcode, block,
-          ft_other_face);
-      pageno += npages;
+  if (print_outline)
+    fntsample_set_outline_func(ctx, print_outline_entry, NULL);
 
-      /* Draw comments */
-      if (xml_file_name && ucd_blocks) {
-        draw_ucd_data(cr, ft_face, font, charcode);
-      }
-    }
-    charcode = get_next_char(ft_face, charcode, &idx);
-  }
-}
+  if (progress_fd >= 0)
+    start_progress(prog);
 
-/*
- * Print usage instructions and default values for styles
- */
-static void usage(const char *cmd) {
-  const struct fntsample_style *style;
+  if (instances_spec)
+    status = write_instances(prog);
+  else if (svg_pages_output)
+    status = write_svg_pages(output_file_name);
+  else status = write_samples(prog, output_file_name, NULL, 0);
 
-  fprintf(stderr, _("Usage: %s [ OPTIONS ] -f FONT-FILE -o OUTPUT-FILE\n"
-      "       %s -h\n\n"), cmd, cmd);
-  fprintf(stderr,
-      _("Options:\n"
-          "  --font-file,         -f FONT-FILE    Create samples of FONT-FILE\n"
-          "  --font-index,        -n IDX          Font index in FONT-FILE\n"
-          "  --output-file,       -o OUTPUT-FILE  Save samples to OUTPUT-FILE\n"
-          "  --help,              -h              Show this information message and exit\n"
-          "  --other-font-file,   -d OTHER-FONT   Compare FONT-FILE with OTHER-FONT and highlight added glyphs\n"
-          "  --other-index,       -m IDX          Font index in OTHER-FONT\n"
-          "  --postscript-output, -s              Use PostScript format for output instead of PDF\n"
-          "  --svg,               -g              Use SVG format for output\n"
-          "  --print-outline,     -l              Print document outlines data to standard output\n"
-          "  --include-range,     -i RANGE        Show characters in RANGE\n"
-          "  --exclude-range,     -x RANGE        Do not show characters in RANGE\n"
-          "  --ucd-xml-file,      -r XML_FILE     UCD data in XML_FILE\n"
-          "  --style,             -t \"STYLE: VAL\" Set STYLE to value VAL\n"));
-  fprintf(stderr, _("\nSupported styles (and default values):\n"));
-  for (style = styles; style->name; style++)
-    fprintf(stderr, "\t%s (%s)\n", style->name, style->default_val);
+  if (progress.out)
+    finish_progress(status);
+  return status;
 }
 
 /*
- * Try to get font name for a given font face.
- * Returned name should be free()'d after use.
- * If function cannot allocate memory, it terminates the program.
+ * Render samples or the report, tracing the run if requested.
  */
-static const char *get_font_name(FT_Face face) {
-  FT_Error error;
-  FT_SfntName face_name;
-  char *fontname;
-
-  /* try SFNT format */
-  error = FT_Get_Sfnt_Name(face, 4 /* full font name */, &face_name);
-  if (!error) {
-    fontname = malloc(face_name.string_len + 1);
-    if (!fontname) {
-      perror("malloc");
-      exit(1);
-    }
-    memcpy(fontname, face_name.string, face_name.string_len);
-    fontname[face_name.string_len] = '\0';
-    return fontname;
-  }
+static int render_font(const char *prog) {
+  int status;
 
-  /* try Type1 format */
-  PS_FontInfoRec fontinfo;
-
-  error = FT_Get_PS_Font_Info(face, &fontinfo);
-  if (!error) {
-    if (fontinfo.full_name) {
-      fontname = strdup(fontinfo.full_name);
-      if (!fontname) {
-        perror("strdup");
-        exit(1);
-      }
-      return fontname;
-    }
+  if (trace_file_name && fntsample_trace_open(trace_file_name)) {
+    fprintf(stderr, "%s: ", prog);
+    perror(trace_file_name);
+    exit(1);
   }
 
-  /* fallback */
-  const char *family_name = face->family_name ? face->family_name : "Unknown";
-  const char *style_name = face->style_name ? face->style_name : "";
-  size_t len = strlen(family_name) + strlen(style_name) + 1/* for space */;
+  status = render_samples(prog);
 
-  fontname = malloc(len + 1);
-  if (!fontname) {
-    perror("malloc");
-    exit(1);
+  if (trace_file_name && fntsample_trace_close() && !status) {
+    perror(trace_file_name);
+    status = 1;
   }
-
-  sprintf(fontname, "%s %s", family_name, style_name);
-  return fontname;
+  return status;
 }
 
 /*
- * Initialize fonts used to print table headers and character codes.
+ * Run one job of the render server. Called in a freshly forked process,
+ * options given to the server act as defaults for the job.
  */
-static void init_pango_fonts(void) {
-  /* FIXME is this correct? */
-  PangoCairoFontMap *map =
-      (PangoCairoFontMap *) pango_cairo_font_map_get_default();
-
-  pango_cairo_font_map_set_resolution(map, 72.0);
-
-  header_font = pango_font_description_from_string(get_style("header-font"));
-  font_name_font = pango_font_description_from_string(
-      get_style("font-name-font"));
-  table_numbers_font = pango_font_description_from_string(
-      get_style("table-numbers-font"));
-  cell_numbers_font = pango_font_description_from_string(
-      get_style("cell-numbers-font"));
+static int run_server_job(int argc, char **argv) {
+  /*
+   * Options of the server itself are not defaults for the job, so -S and
+   * -C can only come from the job's own arguments.
+   */
+  server_socket = NULL;
+  client_socket = NULL;
+  server_jobs = 0;
+
+  optind = 0; /* restart getopt */
+  parse_options(argc, argv);
+  if (server_socket || client_socket) {
+    fprintf(stderr, _("%s: nested server jobs are not allowed\n"), argv[0]);
+    return 1;
+  }
+  /* Only standard output and error are passed from the client */
+  if (progress_fd > STDERR_FILENO) {
+    fprintf(stderr, _("%s: server jobs can write progress only to descriptors 1 and 2\n"),
+        argv[0]);
+    return 1;
+  }
+
+  return render_font(argv[0]);
 }
 
 /*
- * Calculate various offsets.
+ * Get the absolute name of the file 'file_name' (NULL if not given).
+ * Names of files that do not exist are returned unchanged.
  */
-static void calculate_offsets(cairo_t *cr) {
-  PangoRectangle extents;
-  /* Assume that vertical extents does not depend on actual text */
-  PangoLayout *l = layout_text(cr, cell_numbers_font, "0123456789ABCDEF",
-      &extents);
-  g_object_unref(l);
-  /* Unsolved mistery of pango's font metrics.... */
-  double digits_ascent = pango_units_to_double(PANGO_DESCENT(extents));
-  double digits_descent = -pango_units_to_double(PANGO_ASCENT(extents));
-
-  cell_label_offset = digits_descent + 2;
-  cell_glyph_bot_offset = cell_label_offset + digits_ascent + 2;
+static const char *absolute_path(const char *file_name) {
+  char *path;
+
+  if (!file_name)
+    return NULL;
+
+  path = realpath(file_name, NULL);
+  return path ? path : file_name;
 }
 
 /*
- * Create cairo scaled font with the best size (hopefuly...)
+ * Send the job to the render server. All options except --client are
+ * passed to the server unchanged.
  */
-static cairo_scaled_font_t *create_default_font(FT_Face ft_face) {
-  cairo_font_face_t *cr_face = cairo_ft_font_face_create_for_ft_face(ft_face,
-      0);
-  cairo_matrix_t font_matrix;
-  cairo_matrix_t ctm;
-  cairo_font_options_t *options = cairo_font_options_create();
-  cairo_scaled_font_t *cr_font;
-  cairo_font_extents_t extents;
-
-  /* First create font with size 1 and measure it */
-  cairo_matrix_init_identity(&font_matrix);
-  cairo_matrix_init_identity(&ctm);
-  /* Turn off rounding, so we can get real metrics */
-  cairo_font_options_set_hint_metrics(options, CAIRO_HINT_METRICS_OFF);
-  cr_font = cairo_scaled_font_create(cr_face, &font_matrix, &ctm, options);
-  cairo_scaled_font_extents(cr_font, &extents);
-
-  /* Use some magic to find the best font size... */
-  double tgt_size = cell_height - cell_glyph_bot_offset - 2;
-  if (tgt_size <= 0) {
-    fprintf(stderr,
-        _("Not enough space for rendering glyphs. Make cell font smaller.\n"));
-    exit(5);
+static int submit_job(int argc, char **argv) {
+  char **job_argv = malloc(sizeof(*job_argv) * (argc + 1));
+  int job_argc = 0, next = 1, status;
+
+  if (!job_argv) {
+    perror("malloc");
+    exit(1);
   }
-  double act_size = extents.ascent + extents.descent;
-  if (act_size <= 0) {
-    fprintf(stderr, _("The font has strange metrics: ascent + descent = %g\n"),
-        act_size);
-    exit(5);
+
+  /*
+   * Find --client with getopt, as it was parsed, so that arguments of other
+   * options are never taken for it. Options were already checked.
+   */
+  job_argv[job_argc++] = argv[0];
+  optind = 0; /* restart getopt */
+  opterr = 0;
+  for (;;) {
+    int start = optind ? optind : 1;
+    int c = getopt_long(argc, argv, shortopts, longopts, NULL);
+
+    if (c == -1)
+      break;
+    if (c != 'C')
+      continue;
+
+    /* Keep the arguments before the option, it spans start..optind-1 */
+    while (next < start)
+      job_argv[job_argc++] = argv[next++];
+
+    /* Keep short options grouped before it, like -lC SOCKET */
+    if (argv[start][1] != '-' && argv[start][1] != 'C') {
+      *strchr(argv[start] + 1, 'C') = '\0';
+      job_argv[job_argc++] = argv[start];
+    }
+    next = optind;
   }
-  double scale = tgt_size / act_size;
-  if (scale > 1)
-    scale = trunc(scale); // just to make numbers nicer
-  if (scale > 20)
-    scale = 20; // Do not make font larger than in previous versions
-
-  cairo_scaled_font_destroy(cr_font);
-
-  /* Create the font once again, but this time scaled */
-  cairo_matrix_init_scale(&font_matrix, scale, scale);
-  cr_font = cairo_scaled_font_create(cr_face, &font_matrix, &ctm, options);
-  cairo_scaled_font_extents(cr_font, &extents);
-  glyph_baseline_offset = (tgt_size - (extents.ascent + extents.descent)) / 2
-      + 2 + extents.ascent;
-  return cr_font;
+  opterr = 1;
+  while (next < argc)
+    job_argv[job_argc++] = argv[next++];
+  job_argv[job_argc] = NULL;
+
+  status = run_client(client_socket, job_argc, job_argv);
+  free(job_argv);
+  return status < 0 ? 1 : status;
 }
 
 int main(int argc, char **argv) {
-  cairo_surface_t *surface;
-  cairo_t *cr;
-  FT_Error error;
-  FT_Library library;
-  FT_Face face, other_face = NULL;
-  const char *fontname; /* full name of the font */
-  cairo_status_t cr_status;
-  cairo_scaled_font_t *cr_font;
-
   setlocale(LC_ALL, "");
   bindtextdomain(PACKAGE, LOCALEDIR);
   textdomain(PACKAGE);
 
-  parse_options(argc, argv);
-
-  error = FT_Init_FreeType(&library);
-  if (error) {
+  ctx = fntsample_context_new(argv[0]);
+  if (!ctx) {
     /* TRANSLATORS: 'freetype' is a name of a library, and should be left untranslated */
     fprintf(stderr, _("%s: freetype error\n"), argv[0]);
     exit(3);
   }
 
-  error = FT_New_Face(library, font_file_name, font_index, &face);
-  if (error) {
-    fprintf(stderr, _("%s: failed to open font file %s\n"), argv[0],
-        font_file_name);
-    exit(4);
-  }
-
-  fontname = get_font_name(face);
-
-  if (other_font_file_name) {
-    error = FT_New_Face(library, other_font_file_name, other_index,
-        &other_face);
-    if (error) {
-      fprintf(stderr, _("%s: failed to create new font face\n"), argv[0]);
-      exit(4);
-    }
-  }
-
-  if (postscript_output)
-    surface = cairo_ps_surface_create(output_file_name, A4_WIDTH, A4_HEIGHT);
-  else if (svg_output)
-    surface = cairo_svg_surface_create(output_file_name, A4_WIDTH, A4_HEIGHT);
-  else surface = cairo_pdf_surface_create(output_file_name, A4_WIDTH,
-      A4_HEIGHT); /* A4 paper */
-
-  cr_status = cairo_surface_status(surface);
-  if (cr_status != CAIRO_STATUS_SUCCESS) {
-    /* TRANSLATORS: 'cairo' is a name of a library, and should be left untranslated */
-    fprintf(stderr, _("%s: failed to create cairo surface: %s\n"), argv[0],
-        cairo_status_to_string(cr_status));
-    exit(1);
-  }
+  parse_options(argc, argv);
 
-  cr = cairo_create(surface);
-  cr_status = cairo_status(cr);
-  if (cr_status != CAIRO_STATUS_SUCCESS) {
-    fprintf(stderr, _("%s: cairo_create failed: %s\n"), argv[0],
-        cairo_status_to_string(cr_status));
-    exit(1);
-  }
+  if (client_socket)
+    return submit_job(argc, argv);
 
-  cairo_surface_destroy(surface);
+  if (server_socket) {
+    /* Jobs run in the directories of their clients, not of the server */
+    font_file_name = absolute_path(font_file_name);
+    other_font_file_name = absolute_path(other_font_file_name);
+    xml_file_name = absolute_path(xml_file_name);
 
-  init_pango_fonts();
-  calculate_offsets(cr);
-  cr_font = create_default_font(face);
-  cr_status = cairo_scaled_font_status(cr_font);
-  if (cr_status != CAIRO_STATUS_SUCCESS) {
-    fprintf(stderr, _("%s: failed to create scaled font: %s\n"), argv[0],
-        cairo_status_to_string(cr_status));
+    /* Do all expensive initialization once, jobs inherit it */
+    if (fntsample_init_fonts(ctx))
+      exit(1);
+    if (xml_file_name)
+      fntsample_load_ucd_xml(ctx, xml_file_name);
+    run_server(server_socket,
+        server_jobs ? server_jobs : g_get_num_processors(), run_server_job);
     exit(1);
   }
 
-  cairo_set_source_rgb(cr, 0.0, 0.0, 0.0);
-  draw_glyphs(cr, cr_font, face, fontname, other_face);
-  cairo_destroy(cr);
-  return 0;
+  return render_font(argv[0]);
 }
@@ -0,0 +1,297 @@
+/*
+ * fntsample_bench.c
+ *
+ * Microbenchmarks of the helpers on the hot paths of the renderer. The
+ * renderer is included directly, so that its static functions can be
+ * called. Every benchmark reports time and number of heap allocations per
+ * operation; allocations are counted by wrapping the glibc allocator.
+ *
+ * Usage: fntsample-bench [FONT-FILE]
+ * Glyph positioning is measured only if FONT-FILE is given.
+ */
+
+#include "libfntsample.c"
+
+#include <time.h>
+
+/* Run every benchmark for at least this long */
+#define MIN_BENCH_TIME_NS 200000000.0
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t nmemb, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void __libc_free(void *ptr);
+
+static unsigned long allocations;
+
+void *malloc(size_t size) {
+  allocations++;
+  return __libc_malloc(size);
+}
+
+void *calloc(size_t nmemb, size_t size) {
+  allocations++;
+  return __libc_calloc(nmemb, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+  allocations++;
+  return __libc_realloc(ptr, size);
+}
+
+void free(void *ptr) {
+  __libc_free(ptr);
+}
+
+/* Results are accumulated here, so that calls are not optimized out */
+static volatile unsigned long sink;
+
+typedef void (*bench_func)(void *data, unsigned long ops);
+
+static double now_ns(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* Run 'func' with growing number of operations until it runs long enough */
+static void run_bench(const char *name, bench_func func, void *data) {
+  unsigned long ops = 1, allocs;
+  double start, elapsed;
+
+  func(data, 1); /* warm up caches */
+
+  for (;;) {
+    allocs = allocations;
+    start = now_ns();
+    func(data, ops);
+    elapsed = now_ns() - start;
+    allocs = allocations - allocs;
+    if (elapsed >= MIN_BENCH_TIME_NS || ops >= (1UL << 40))
+      break;
+    ops *= elapsed > 0 ? MIN(MAX(MIN_BENCH_TIME_NS / elapsed * 1.2, 2.0), 100.0) : 100;
+  }
+
+  printf("%-36s %12.1f %12.2f\n", name, elapsed / ops, (double) allocs / ops);
+}
+
+static void bench_in_range(void *data, unsigned long ops) {
+  struct fntsample_context *ctx = data;
+  unsigned long i;
+
+  for (i = 0; i < ops; i++)
+    sink += in_range(ctx, (i * 7919) & 0x1FFFF);
+}
+
+static void bench_get_unicode_block(void *data, unsigned long ops) {
+  unsigned long i;
+
+  (void) data;
+  for (i = 0; i < ops; i++)
+    sink += get_unicode_block((i * 7919) % 0x110000) != NULL;
+}
+
+static void bench_find_ucd_block(void *data, unsigned long ops) {
+  const struct ucd_data *ucd = data;
+  unsigned long i;
+
+  for (i = 0; i < ops; i++)
+    sink += find_ucd_block(ucd, (i * 7919) % 0x30000) != NULL;
+}
+
+static void bench_parse_ucd(void *data, unsigned long ops) {
+  xmlDoc *doc = data;
+  unsigned long i;
+
+  for (i = 0; i < ops; i++) {
+    struct ucd_data *ucd = parse_ucd_from_xml(
+        xmlDocGetRootElement(doc)->children);
+
+    sink += ucd != NULL;
+    free_ucd_data(ucd);
+  }
+}
+
+/* Label and glyph benchmarks draw into a recording surface */
+struct draw_bench {
+  struct fntsample_context *ctx;
+  cairo_t *cr;
+  unsigned long num_glyphs;
+};
+
+static void bench_layout_text(void *data, unsigned long ops) {
+  struct draw_bench *b = data;
+  PangoRectangle r;
+  unsigned long i;
+
+  for (i = 0; i < ops; i++) {
+    char buf[9];
+    PangoLayout *layout;
+
+    snprintf(buf, sizeof(buf), "%04lX", i & 0xFFFF);
+    layout = layout_text(b->ctx, b->ctx->cell_numbers_font, buf, &r);
+    sink += r.width;
+    g_object_unref(layout);
+  }
+}
+
+static void bench_draw_charcode(void *data, unsigned long ops) {
+  struct draw_bench *b = data;
+  unsigned long i;
+
+  for (i = 0; i < ops; i++)
+    draw_charcode(b->ctx, b->cr, CELL_X(b->ctx, xmin_border, i & 0xFF),
+        CELL_Y(b->ctx, i & 0xFF), i & 0xFFFF);
+}
+
+static void bench_position_glyph(void *data, unsigned long ops) {
+  struct draw_bench *b = data;
+  cairo_glyph_t glyph;
+  unsigned long i;
+
+  for (i = 0; i < ops; i++) {
+    position_glyph(b->ctx, b->cr, CELL_X(b->ctx, xmin_border, i & 0xFF),
+        CELL_Y(b->ctx, i & 0xFF), i % b->num_glyphs, &glyph);
+    sink += glyph.x > 0;
+  }
+}
+
+/* Synthetic list of 'n' UCD blocks of 64 characters each */
+static struct ucd_data *make_ucd_blocks(unsigned int n) {
+  struct ucd_data *ucd = calloc(1, sizeof(*ucd));
+  unsigned int i;
+
+  ucd->blocks = calloc(n, sizeof(*ucd->blocks));
+  ucd->n_blocks = n;
+  for (i = 0; i < n; i++) {
+    ucd->blocks[i].start = i * 64;
+    ucd->blocks[i].end = ucd->blocks[i].start + 63;
+    ucd->blocks[i].name = UCD_NO_STRING;
+  }
+  return ucd;
+}
+
+/* Synthetic UCD document with 'n' blocks of 64 characters each */
+static xmlDoc *make_ucd_doc(unsigned int n) {
+  xmlDoc *doc = xmlNewDoc(BAD_CAST "1.0");
+  xmlNode *root = xmlNewNode(NULL, BAD_CAST "ucd");
+  unsigned int i, j;
+  char buf[32];
+
+  xmlDocSetRootElement(doc, root);
+  for (i = 0; i < n; i++) {
+    xmlNode *block = xmlNewChild(root, NULL, BAD_CAST "block_header", NULL);
+    xmlNode *sub = xmlNewChild(block, NULL, BAD_CAST "block_subheader", NULL);
+
+    snprintf(buf, sizeof(buf), "%04X", i * 64);
+    xmlNewProp(block, BAD_CAST "block_start", BAD_CAST buf);
+    snprintf(buf, sizeof(buf), "%04X", i * 64 + 63);
+    xmlNewProp(block, BAD_CAST "block_end", BAD_CAST buf);
+    xmlNewProp(block, BAD_CAST "name", BAD_CAST "Block");
+    xmlNewProp(sub, BAD_CAST "name", BAD_CAST "Subheader");
+
+    for (j = 0; j < 64; j++) {
+      xmlNode *entry = xmlNewChild(sub, NULL, BAD_CAST "char_entry", NULL);
+      xmlNode *alias = xmlNewChild(entry, NULL, BAD_CAST "alias_line", NULL);
+
+      snprintf(buf, sizeof(buf), "%04X", i * 64 + j);
+      xmlNewProp(entry, BAD_CAST "code_point", BAD_CAST buf);
+      xmlNewProp(entry, BAD_CAST "name", BAD_CAST "CHARACTER NAME");
+      xmlNewProp(alias, BAD_CAST "content", BAD_CAST "alias");
+    }
+  }
+  return doc;
+}
+
+int main(int argc, char **argv) {
+  static const unsigned int range_counts[] = { 1, 10, 100, 1000 };
+  static const unsigned int block_counts[] = { 10, 100, 1000 };
+  struct fntsample_context *ctx;
+  struct draw_bench draw;
+  cairo_rectangle_t page = { 0, 0, A4_WIDTH, A4_HEIGHT };
+  cairo_surface_t *surface;
+  char name[64];
+  unsigned int i, j;
+
+  ctx = fntsample_context_new(argv[0]);
+  if (!ctx || fntsample_init_fonts(ctx)) {
+    fprintf(stderr, "%s: initialization failed\n", argv[0]);
+    return 1;
+  }
+
+  printf("%-36s %12s %12s\n", "benchmark", "ns/op", "allocs/op");
+
+  for (i = 0; i < G_N_ELEMENTS(range_counts); i++) {
+    struct fntsample_context *rctx = fntsample_context_new(argv[0]);
+
+    for (j = 0; j < range_counts[i]; j++)
+      fntsample_add_range(rctx, j * 64, j * 64 + 31, j % 2 == 0);
+    snprintf(name, sizeof(name), "in_range/%u", range_counts[i]);
+    run_bench(name, bench_in_range, rctx);
+    fntsample_context_free(rctx);
+  }
+
+  run_bench("get_unicode_block", bench_get_unicode_block, NULL);
+
+  for (i = 0; i < G_N_ELEMENTS(block_counts); i++) {
+    struct ucd_data *ucd = make_ucd_blocks(block_counts[i]);
+
+    snprintf(name, sizeof(name), "find_ucd_block/%u", block_counts[i]);
+    run_bench(name, bench_find_ucd_block, ucd);
+    free_ucd_data(ucd);
+  }
+
+  for (i = 0; i < G_N_ELEMENTS(block_counts); i++) {
+    xmlDoc *doc = make_ucd_doc(block_counts[i]);
+
+    snprintf(name, sizeof(name), "parse_ucd_from_xml/%u", block_counts[i]);
+    run_bench(name, bench_parse_ucd, doc);
+    xmlFreeDoc(doc);
+  }
+
+  surface = cairo_recording_surface_create(CAIRO_CONTENT_COLOR_ALPHA, &page);
+  draw.ctx = ctx;
+  draw.cr = cairo_create(surface);
+  pango_cairo_update_context(draw.cr, ctx->pango_context);
+  calculate_offsets(ctx);
+
+  run_bench("layout_text", bench_layout_text, &draw);
+  run_bench("draw_charcode", bench_draw_charcode, &draw);
+
+  if (argc > 1) {
+    cairo_font_face_t *cr_face;
+    cairo_scaled_font_t *cr_font;
+    FT_Face face;
+
+    if (fntsample_set_font(ctx, argv[1], 0)
+        || !(cr_face = open_font_face(ctx, &face))) {
+      fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[1]);
+      return 1;
+    }
+
+    ctx->glyph_metrics = glyph_metrics_load(argv[1], 0, face);
+    cr_font = create_default_font(ctx, cr_face);
+    if (!cr_font) {
+      fprintf(stderr, "%s: cannot create font for %s\n", argv[0], argv[1]);
+      return 1;
+    }
+    cairo_set_scaled_font(draw.cr, cr_font);
+    draw.num_glyphs = face->num_glyphs > 0 ? face->num_glyphs : 1;
+
+    run_bench("position_glyph/metrics", bench_position_glyph, &draw);
+
+    /* The same without the bulk metrics table, asking cairo */
+    glyph_metrics_free(ctx->glyph_metrics);
+    ctx->glyph_metrics = NULL;
+    run_bench("position_glyph/cairo", bench_position_glyph, &draw);
+
+    cairo_scaled_font_destroy(cr_font);
+    cairo_font_face_destroy(cr_face);
+  }
+
+  cairo_destroy(draw.cr);
+  cairo_surface_destroy(surface);
+  fntsample_context_free(ctx);
+  return 0;
+}
@@ -0,0 +1,135 @@
+/*
+ * font_blob.c
+ *
+ * Mapped files are kept in a list keyed by device, inode, size and
+ * modification time, so a file replaced on disk is mapped anew. Every face
+ * holds a reference to its blob and drops it from the face finalizer.
+ * Faces may be opened and freed from different threads, the list is
+ * protected by a mutex.
+ */
+
+#include "font_blob.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <glib.h>
+
+struct font_blob {
+  dev_t dev;
+  ino_t ino;
+  off_t size;
+  time_t mtime;
+  void *data;
+  unsigned int refcount;
+  struct font_blob *next;
+};
+
+static GMutex blobs_lock;
+static struct font_blob *blobs;
+
+static bool blob_matches(const struct font_blob *blob, const struct stat *st) {
+  return blob->dev == st->st_dev && blob->ino == st->st_ino
+      && blob->size == st->st_size && blob->mtime == st->st_mtime;
+}
+
+/* Map the file, or return its existing mapping. Returns NULL on error. */
+static struct font_blob *get_blob(const char *file_name) {
+  struct font_blob *blob;
+  struct stat st;
+  int fd;
+
+  fd = open(file_name, O_RDONLY);
+  if (fd == -1)
+    return NULL;
+
+  if (fstat(fd, &st) || !S_ISREG(st.st_mode) || st.st_size == 0) {
+    close(fd);
+    return NULL;
+  }
+
+  g_mutex_lock(&blobs_lock);
+
+  for (blob = blobs; blob; blob = blob->next) {
+    if (blob_matches(blob, &st)) {
+      blob->refcount++;
+      g_mutex_unlock(&blobs_lock);
+      close(fd);
+      return blob;
+    }
+  }
+
+  blob = malloc(sizeof(*blob));
+  if (blob) {
+    blob->data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (blob->data == MAP_FAILED) {
+      free(blob);
+      blob = NULL;
+    }
+  }
+
+  if (blob) {
+    blob->dev = st.st_dev;
+    blob->ino = st.st_ino;
+    blob->size = st.st_size;
+    blob->mtime = st.st_mtime;
+    blob->refcount = 1;
+    blob->next = blobs;
+    blobs = blob;
+  }
+
+  g_mutex_unlock(&blobs_lock);
+  close(fd);
+  return blob;
+}
+
+static void unref_blob(struct font_blob *blob) {
+  struct font_blob **p;
+
+  g_mutex_lock(&blobs_lock);
+
+  if (--blob->refcount) {
+    g_mutex_unlock(&blobs_lock);
+    return;
+  }
+
+  for (p = &blobs; *p != blob; p = &(*p)->next)
+    ;
+  *p = blob->next;
+
+  g_mutex_unlock(&blobs_lock);
+
+  munmap(blob->data, blob->size);
+  free(blob);
+}
+
+/* Called by FreeType from FT_Done_Face() */
+static void finalize_face(void *object) {
+  FT_Face face = object;
+
+  unref_blob(face->generic.data);
+}
+
+FT_Error font_blob_new_face(FT_Library library, const char *file_name,
+    FT_Long face_index, FT_Face *face) {
+  struct font_blob *blob = get_blob(file_name);
+  FT_Error error;
+
+  if (!blob)
+    return FT_New_Face(library, file_name, face_index, face);
+
+  error = FT_New_Memory_Face(library, blob->data, blob->size, face_index,
+      face);
+  if (error) {
+    unref_blob(blob);
+    return error;
+  }
+
+  (*face)->generic.data = blob;
+  (*face)->generic.finalizer = finalize_face;
+  return 0;
+}
@@ -0,0 +1,24 @@
+/*
+ * font_blob.h
+ *
+ * Font files mapped into memory once and shared by all faces opened from
+ * them: faces of a collection, the main and the comparison font, and the
+ * faces of worker threads.
+ */
+
+#ifndef FONT_BLOB_H_
+#define FONT_BLOB_H_
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+/*
+ * Open face 'face_index' of 'file_name' like FT_New_Face(), but from
+ * the shared read-only mapping of the file. The mapping is released when
+ * the last face using it is freed with FT_Done_Face().
+ * Falls back to FT_New_Face() if the file cannot be mapped.
+ */
+FT_Error font_blob_new_face(FT_Library library, const char *file_name,
+    FT_Long face_index, FT_Face *face);
+
+#endif /* FONT_BLOB_H_ */
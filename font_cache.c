@@ -0,0 +1,264 @@
+/*
+ * font_cache.c
+ *
+ * A cache file is a header followed by the characters and the glyph
+ * metrics, in the native byte order and layout, so it is used right from
+ * its read-only mapping. The header repeats the key and the size of the
+ * metrics structure; files that do not match (written by another build,
+ * for a font changed since, or truncated) are ignored and written again.
+ * Files are written under a temporary name and renamed, so concurrent
+ * runs never see partial files.
+ */
+
+#include "font_cache.h"
+#include "trace.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define CACHE_MAGIC "FNTCACH2"
+
+struct cache_header {
+  char magic[8];
+  uint32_t metrics_size; /* sizeof(struct glyph_metrics) of the writer */
+  uint32_t units_per_em;
+  struct font_cache_key key;
+  uint64_t num_chars;
+  uint64_t num_glyphs; /* 0 if there are no metrics */
+};
+
+int font_cache_key(const char *file_name, FT_Long face_index,
+    struct font_cache_key *key) {
+  struct stat st;
+
+  if (stat(file_name, &st) || !S_ISREG(st.st_mode))
+    return -1;
+
+  /* Padding would take part in comparisons of the keys */
+  memset(key, 0, sizeof(*key));
+  key->dev = st.st_dev;
+  key->ino = st.st_ino;
+  key->size = st.st_size;
+  key->mtime = (int64_t) st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+  key->face_index = face_index;
+  return 0;
+}
+
+char *font_cache_path(const char *dir, const struct font_cache_key *key,
+    const char *ext) {
+  int len = snprintf(NULL, 0, "%s/%016llx-%016llx-%lld.%s", dir,
+      (unsigned long long) key->dev, (unsigned long long) key->ino,
+      (long long) key->face_index, ext);
+  char *path = malloc(len + 1);
+
+  if (path)
+    sprintf(path, "%s/%016llx-%016llx-%lld.%s", dir,
+        (unsigned long long) key->dev, (unsigned long long) key->ino,
+        (long long) key->face_index, ext);
+  return path;
+}
+
+static size_t cache_size(const struct cache_header *header) {
+  return sizeof(*header) + header->num_chars * sizeof(struct font_cache_char)
+      + header->num_glyphs * sizeof(struct glyph_metrics);
+}
+
+/* Map the cache file if it matches 'key'. Returns -1 if it cannot be used. */
+static int map_cache(struct font_cache *cache, const char *path,
+    const struct cache_header *key) {
+  const struct cache_header *header;
+  struct stat st;
+  void *map;
+  int fd;
+
+  fd = open(path, O_RDONLY);
+  if (fd == -1)
+    return -1;
+
+  if (fstat(fd, &st) || (size_t) st.st_size < sizeof(*header)) {
+    close(fd);
+    return -1;
+  }
+
+  map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED)
+    return -1;
+
+  header = map;
+  if (memcmp(header->magic, key->magic, sizeof(header->magic))
+      || header->metrics_size != key->metrics_size
+      || memcmp(&header->key, &key->key, sizeof(header->key))
+      || header->num_chars > (uint64_t) st.st_size
+      || header->num_glyphs > (uint64_t) st.st_size
+      || cache_size(header) != (size_t) st.st_size) {
+    munmap(map, st.st_size);
+    return -1;
+  }
+
+  cache->map = map;
+  cache->map_size = st.st_size;
+  cache->num_chars = header->num_chars;
+  cache->chars = (const struct font_cache_char *) (header + 1);
+  if (header->num_glyphs) {
+    cache->table.num_glyphs = header->num_glyphs;
+    cache->table.units_per_em = header->units_per_em;
+    cache->table.metrics = (struct glyph_metrics *) (cache->chars
+        + cache->num_chars);
+    cache->metrics = &cache->table;
+  }
+  return 0;
+}
+
+/* Walk the character map and measure glyphs of the face */
+static int collect(struct font_cache *cache, const char *file_name,
+    FT_Long face_index, FT_Face face) {
+  struct font_cache_char *chars;
+  size_t size = 1024;
+  FT_ULong charcode;
+  FT_UInt idx;
+
+  chars = malloc(size * sizeof(*chars));
+  if (!chars)
+    return -1;
+
+  for (charcode = FT_Get_First_Char(face, &idx); idx;
+      charcode = FT_Get_Next_Char(face, charcode, &idx)) {
+    if (cache->num_chars == size) {
+      struct font_cache_char *p;
+
+      size *= 2;
+      p = realloc(chars, size * sizeof(*chars));
+      if (!p) {
+        free(chars);
+        return -1;
+      }
+      chars = p;
+    }
+    chars[cache->num_chars].charcode = charcode;
+    chars[cache->num_chars].idx = idx;
+    cache->num_chars++;
+  }
+
+  cache->chars = chars;
+  cache->metrics = glyph_metrics_load(file_name, face_index, face);
+  return 0;
+}
+
+/* Write the collected data to 'path'. Returns -1 on error. */
+static int store(const struct font_cache *cache, const char *dir,
+    const char *path, struct cache_header *header) {
+  char *tmp_path;
+  FILE *f;
+  int fd, status = 0;
+
+  header->num_chars = cache->num_chars;
+  if (cache->metrics) {
+    header->num_glyphs = cache->metrics->num_glyphs;
+    header->units_per_em = cache->metrics->units_per_em;
+  }
+
+  /* The directory may not exist yet, other errors show up below */
+  mkdir(dir, 0777);
+
+  tmp_path = malloc(strlen(path) + sizeof(".XXXXXX"));
+  if (!tmp_path)
+    return -1;
+  sprintf(tmp_path, "%s.XXXXXX", path);
+
+  fd = mkstemp(tmp_path);
+  if (fd == -1) {
+    free(tmp_path);
+    return -1;
+  }
+  f = fdopen(fd, "wb");
+  if (!f) {
+    close(fd);
+    unlink(tmp_path);
+    free(tmp_path);
+    return -1;
+  }
+
+  if (fwrite(header, sizeof(*header), 1, f) != 1
+      || fwrite(cache->chars, sizeof(*cache->chars), cache->num_chars, f)
+          != cache->num_chars
+      || (cache->metrics
+          && fwrite(cache->metrics->metrics, sizeof(struct glyph_metrics),
+              cache->metrics->num_glyphs, f) != cache->metrics->num_glyphs))
+    status = -1;
+  if (fclose(f))
+    status = -1;
+  /* Cache files are shared, like the fonts themselves */
+  if (!status && chmod(tmp_path, 0644))
+    status = -1;
+
+  if (status || rename(tmp_path, path)) {
+    unlink(tmp_path);
+    status = -1;
+  }
+  free(tmp_path);
+  return status;
+}
+
+struct font_cache *font_cache_load(const char *dir, const char *file_name,
+    FT_Long face_index, FT_Face face) {
+  struct font_cache *cache;
+  struct cache_header header;
+  char *path;
+  int64_t start = trace_begin();
+
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, CACHE_MAGIC, sizeof(header.magic));
+  header.metrics_size = sizeof(struct glyph_metrics);
+  if (font_cache_key(file_name, face_index, &header.key))
+    return NULL;
+
+  path = font_cache_path(dir, &header.key, "fntcache");
+  cache = calloc(1, sizeof(*cache));
+  if (!path || !cache) {
+    free(path);
+    free(cache);
+    return NULL;
+  }
+
+  if (!map_cache(cache, path, &header))
+    trace_end("font_cache", "load", start);
+  else {
+    if (collect(cache, file_name, face_index, face)) {
+      free(path);
+      free(cache);
+      return NULL;
+    }
+
+    /*
+     * The cache only saves time, the data is used even if it is not
+     * stored. Metrics that could not be measured are not stored, so
+     * that the next run tries again.
+     */
+    if (cache->metrics || !FT_IS_SCALABLE(face))
+      store(cache, dir, path, &header);
+    trace_end("font_cache", "collect", start);
+  }
+
+  free(path);
+  return cache;
+}
+
+void font_cache_free(struct font_cache *cache) {
+  if (!cache)
+    return;
+
+  if (cache->map)
+    munmap(cache->map, cache->map_size);
+  else {
+    free((struct font_cache_char *) cache->chars);
+    glyph_metrics_free(cache->metrics);
+  }
+  free(cache);
+}
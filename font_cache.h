@@ -0,0 +1,73 @@
+/*
+ * font_cache.h
+ *
+ * On-disk cache of what is learned about a face by walking its character
+ * map and measuring all its glyphs: characters with their glyph indices
+ * and the glyph metrics table. Entries are keyed by the identity of the
+ * font file (device, inode, size and modification time) and the face
+ * index, so charting the same font again (with other ranges, styles or
+ * UCD data) loads no glyphs at all, and reads no more of the file.
+ */
+
+#ifndef FONT_CACHE_H_
+#define FONT_CACHE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include "glyph_metrics.h"
+
+/* Identity of a face of a font file, see font_cache_key() */
+struct font_cache_key {
+  uint64_t dev;
+  uint64_t ino;
+  uint64_t size;
+  int64_t mtime; /* in nanoseconds */
+  int64_t face_index;
+};
+
+/* Character of the face and its glyph */
+struct font_cache_char {
+  uint32_t charcode;
+  uint32_t idx;
+};
+
+struct font_cache {
+  unsigned long num_chars;
+  const struct font_cache_char *chars; /* sorted by character code */
+  struct glyph_metrics_table *metrics; /* NULL if the font is not scalable */
+
+  /* The cache file mapped into memory, or NULL if data is allocated */
+  void *map;
+  size_t map_size;
+  struct glyph_metrics_table table;
+};
+
+/*
+ * Get characters and glyph metrics of the face 'face_index' of 'file_name'
+ * from the cache directory 'dir'. If they are not there, walk the character
+ * map of 'face' and measure glyphs with glyph_metrics_load(), and store
+ * the results for the next time. Returns NULL on error.
+ */
+struct font_cache *font_cache_load(const char *dir, const char *file_name,
+    FT_Long face_index, FT_Face face);
+
+void font_cache_free(struct font_cache *cache);
+
+/*
+ * Get the key of the face 'face_index' of 'file_name', used by other
+ * caches kept in the same directory. Returns -1 on error.
+ */
+int font_cache_key(const char *file_name, FT_Long face_index,
+    struct font_cache_key *key);
+
+/*
+ * Get the path of the entry of 'key' with the extension 'ext' in 'dir'.
+ * The path should be free()'d after use. Returns NULL on error.
+ */
+char *font_cache_path(const char *dir, const struct font_cache_key *key,
+    const char *ext);
+
+#endif /* FONT_CACHE_H_ */
@@ -0,0 +1,374 @@
+/*
+ * glyph_hash.c
+ *
+ * Glyphs are loaded unscaled, so that the hash depends only on the design
+ * of the glyph: its contours, points and their tags, and the advance.
+ * Composite glyphs are hashed after their components are resolved, so
+ * a changed component changes all glyphs using it. Like the glyph metrics,
+ * hashes are computed by worker threads, each with its own face.
+ *
+ * In the cache directory the hashes of a face are stored after a header
+ * with the key of the face (see font_cache_key()), in the native byte
+ * order, and used right from their read-only mapping.
+ */
+
+#include "glyph_hash.h"
+#include "font_blob.h"
+#include "font_cache.h"
+#include "trace.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <glib.h>
+
+/* Do not bother starting threads for small fonts */
+#define GLYPHS_PER_THREAD_MIN 1024
+
+#define FNV_OFFSET_BASIS 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+#define HASH_FILE_MAGIC "FNTHASH1"
+
+/* Header of a file in the cache directory, followed by the hashes */
+struct hash_file_header {
+  char magic[8];
+  struct font_cache_key key;
+  uint64_t num_glyphs;
+};
+
+struct hash_job {
+  const char *file_name;
+  int face_index;
+  unsigned long first;
+  unsigned long last;
+  uint64_t *hashes;
+  bool done; /* false if the face could not be opened */
+};
+
+/* Cached hashes of a single face, the file is identified by its inode */
+struct cached_table {
+  dev_t dev;
+  ino_t ino;
+  off_t size;
+  time_t mtime;
+  int face_index;
+  struct glyph_hash_table table;
+  struct cached_table *next;
+};
+
+static GMutex cache_lock;
+static struct cached_table *cache;
+
+/* FNV-1a */
+static uint64_t hash_bytes(uint64_t hash, const void *data, size_t len) {
+  const unsigned char *p = data;
+
+  while (len--) {
+    hash ^= *p++;
+    hash *= FNV_PRIME;
+  }
+  return hash;
+}
+
+static uint64_t hash_int(uint64_t hash, int32_t val) {
+  return hash_bytes(hash, &val, sizeof(val));
+}
+
+static uint64_t hash_glyph(FT_GlyphSlot glyph) {
+  const FT_Outline *outline = &glyph->outline;
+  uint64_t hash = FNV_OFFSET_BASIS;
+  int i;
+
+  hash = hash_int(hash, glyph->format);
+  hash = hash_int(hash, glyph->metrics.horiAdvance);
+  hash = hash_int(hash, glyph->metrics.vertAdvance);
+
+  if (glyph->format == FT_GLYPH_FORMAT_OUTLINE) {
+    hash = hash_int(hash, outline->n_contours);
+    hash = hash_int(hash, outline->n_points);
+    for (i = 0; i < outline->n_contours; i++)
+      hash = hash_int(hash, outline->contours[i]);
+    for (i = 0; i < outline->n_points; i++) {
+      hash = hash_int(hash, outline->points[i].x);
+      hash = hash_int(hash, outline->points[i].y);
+      /* only the on/off curve and cubic bits describe the shape */
+      hash = hash_int(hash, outline->tags[i] & 3);
+    }
+  }
+
+  /* 0 is reserved for glyphs that are not known */
+  return hash ? hash : 1;
+}
+
+/* Hash glyphs [job->first, job->last) using a private face */
+static gpointer hash_glyphs(gpointer data) {
+  struct hash_job *job = data;
+  FT_Library library;
+  FT_Face face;
+  unsigned long i;
+  int64_t start = trace_begin();
+
+  trace_thread_name("glyph-hash");
+  if (FT_Init_FreeType(&library))
+    return NULL;
+
+  if (font_blob_new_face(library, job->file_name, job->face_index, &face)) {
+    FT_Done_FreeType(library);
+    return NULL;
+  }
+
+  for (i = job->first; i < job->last; i++) {
+    if (!FT_Load_Glyph(face, i, FT_LOAD_NO_SCALE))
+      job->hashes[i] = hash_glyph(face->glyph);
+  }
+  job->done = true;
+
+  FT_Done_Face(face);
+  FT_Done_FreeType(library);
+  trace_end("glyph_hash", "hash glyphs", start);
+  return NULL;
+}
+
+/*
+ * Fill the table with hashes of all glyphs. 'complete' is set to false
+ * if some of them could not be tried. Returns -1 on error.
+ */
+static int compute_hashes(struct glyph_hash_table *table,
+    const char *file_name, int face_index, bool *complete) {
+  FT_Library library;
+  FT_Face face;
+  struct hash_job *jobs;
+  GThread **threads;
+  unsigned int nthreads, i;
+  unsigned long chunk;
+
+  /* Only the number of glyphs is needed from this face */
+  if (FT_Init_FreeType(&library))
+    return -1;
+  if (font_blob_new_face(library, file_name, face_index, &face)) {
+    FT_Done_FreeType(library);
+    return -1;
+  }
+  table->num_glyphs = face->num_glyphs > 0 ? face->num_glyphs : 0;
+  FT_Done_Face(face);
+  FT_Done_FreeType(library);
+
+  if (!table->num_glyphs)
+    return -1;
+
+  table->hashes = calloc(table->num_glyphs, sizeof(*table->hashes));
+  if (!table->hashes)
+    return -1;
+
+  nthreads = g_get_num_processors();
+  if (nthreads > table->num_glyphs / GLYPHS_PER_THREAD_MIN)
+    nthreads = table->num_glyphs / GLYPHS_PER_THREAD_MIN;
+  if (nthreads < 1)
+    nthreads = 1;
+
+  jobs = calloc(nthreads, sizeof(*jobs));
+  threads = calloc(nthreads, sizeof(*threads));
+  if (!jobs || !threads) {
+    free(jobs);
+    free(threads);
+    free(table->hashes);
+    return -1;
+  }
+
+  chunk = (table->num_glyphs + nthreads - 1) / nthreads;
+  for (i = 0; i < nthreads; i++) {
+    jobs[i].file_name = file_name;
+    jobs[i].face_index = face_index;
+    jobs[i].first = i * chunk;
+    jobs[i].last = MIN((i + 1) * chunk, table->num_glyphs);
+    jobs[i].hashes = table->hashes;
+  }
+
+  /* The calling thread hashes the first slice itself */
+  for (i = 1; i < nthreads; i++)
+    threads[i] = g_thread_new("glyph-hash", hash_glyphs, &jobs[i]);
+  hash_glyphs(&jobs[0]);
+  for (i = 1; i < nthreads; i++)
+    g_thread_join(threads[i]);
+
+  *complete = true;
+  for (i = 0; i < nthreads; i++)
+    *complete = *complete && jobs[i].done;
+
+  free(threads);
+  free(jobs);
+  return 0;
+}
+
+/* Map the hashes stored in 'path' if they match 'key'. Returns -1 if not. */
+static int load_hashes(struct glyph_hash_table *table, const char *path,
+    const struct font_cache_key *key) {
+  const struct hash_file_header *header;
+  struct stat st;
+  void *map;
+  int fd;
+
+  fd = open(path, O_RDONLY);
+  if (fd == -1)
+    return -1;
+
+  if (fstat(fd, &st) || (size_t) st.st_size < sizeof(*header)) {
+    close(fd);
+    return -1;
+  }
+
+  map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED)
+    return -1;
+
+  header = map;
+  if (memcmp(header->magic, HASH_FILE_MAGIC, sizeof(header->magic))
+      || memcmp(&header->key, key, sizeof(*key)) || !header->num_glyphs
+      || header->num_glyphs > (uint64_t) st.st_size
+      || sizeof(*header) + header->num_glyphs * sizeof(uint64_t)
+          != (size_t) st.st_size) {
+    munmap(map, st.st_size);
+    return -1;
+  }
+
+  /* The mapping is kept as long as the table, for the process lifetime */
+  table->num_glyphs = header->num_glyphs;
+  table->hashes = (uint64_t *) (header + 1);
+  return 0;
+}
+
+/* Store the hashes to 'path' in 'dir'. Returns -1 on error. */
+static int store_hashes(const struct glyph_hash_table *table, const char *dir,
+    const char *path, const struct font_cache_key *key) {
+  struct hash_file_header header;
+  char *tmp_path;
+  FILE *f;
+  int fd, status = 0;
+
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, HASH_FILE_MAGIC, sizeof(header.magic));
+  header.key = *key;
+  header.num_glyphs = table->num_glyphs;
+
+  /* The directory may not exist yet, other errors show up below */
+  mkdir(dir, 0777);
+
+  tmp_path = malloc(strlen(path) + sizeof(".XXXXXX"));
+  if (!tmp_path)
+    return -1;
+  sprintf(tmp_path, "%s.XXXXXX", path);
+
+  fd = mkstemp(tmp_path);
+  if (fd == -1) {
+    free(tmp_path);
+    return -1;
+  }
+  f = fdopen(fd, "wb");
+  if (!f) {
+    close(fd);
+    unlink(tmp_path);
+    free(tmp_path);
+    return -1;
+  }
+
+  if (fwrite(&header, sizeof(header), 1, f) != 1
+      || fwrite(table->hashes, sizeof(*table->hashes), table->num_glyphs, f)
+          != table->num_glyphs)
+    status = -1;
+  if (fclose(f))
+    status = -1;
+  if (!status && chmod(tmp_path, 0644))
+    status = -1;
+
+  if (status || rename(tmp_path, path)) {
+    unlink(tmp_path);
+    status = -1;
+  }
+  free(tmp_path);
+  return status;
+}
+
+/*
+ * Get the table from the cache directory, or compute it and store it
+ * there. Returns -1 on error.
+ */
+static int get_hashes(struct glyph_hash_table *table, const char *cache_dir,
+    const char *file_name, int face_index) {
+  struct font_cache_key key;
+  char *path = NULL;
+  bool complete;
+  int64_t start = trace_begin();
+
+  if (cache_dir && !font_cache_key(file_name, face_index, &key))
+    path = font_cache_path(cache_dir, &key, "fnthash");
+
+  if (path && !load_hashes(table, path, &key)) {
+    trace_end("glyph_hash", "load", start);
+    free(path);
+    return 0;
+  }
+
+  if (compute_hashes(table, file_name, face_index, &complete)) {
+    free(path);
+    return -1;
+  }
+
+  /* Hashes missing because of a failure now are not stored */
+  if (path && complete)
+    store_hashes(table, cache_dir, path, &key);
+  free(path);
+  return 0;
+}
+
+const struct glyph_hash_table *glyph_hash_get_table(const char *cache_dir,
+    const char *file_name, int face_index) {
+  struct cached_table *c;
+  struct stat st;
+
+  if (stat(file_name, &st))
+    return NULL;
+
+  /* Concurrent requests for the same font wait for a single computation */
+  g_mutex_lock(&cache_lock);
+
+  for (c = cache; c; c = c->next) {
+    if (c->dev == st.st_dev && c->ino == st.st_ino && c->size == st.st_size
+        && c->mtime == st.st_mtime && c->face_index == face_index) {
+      g_mutex_unlock(&cache_lock);
+      return &c->table;
+    }
+  }
+
+  c = malloc(sizeof(*c));
+  if (!c || get_hashes(&c->table, cache_dir, file_name, face_index)) {
+    g_mutex_unlock(&cache_lock);
+    free(c);
+    return NULL;
+  }
+
+  c->dev = st.st_dev;
+  c->ino = st.st_ino;
+  c->size = st.st_size;
+  c->mtime = st.st_mtime;
+  c->face_index = face_index;
+  c->next = cache;
+  cache = c;
+
+  g_mutex_unlock(&cache_lock);
+  return &c->table;
+}
+
+uint64_t glyph_hash_get(const struct glyph_hash_table *table,
+    unsigned long idx) {
+  if (!table || idx >= table->num_glyphs)
+    return 0;
+
+  return table->hashes[idx];
+}
@@ -0,0 +1,33 @@
+/*
+ * glyph_hash.h
+ *
+ * Hashes of glyph outlines and advances, used to find glyphs that differ
+ * between two versions of a font. Hashes are computed once per font file
+ * and face and kept for the lifetime of the process, and in the cache
+ * directory (see fntsample_set_cache_dir()) for the following ones.
+ */
+
+#ifndef GLYPH_HASH_H_
+#define GLYPH_HASH_H_
+
+#include <stdint.h>
+
+struct glyph_hash_table {
+  unsigned long num_glyphs;
+  uint64_t *hashes; /* 0 if the glyph could not be loaded */
+};
+
+/*
+ * Get hashes of all glyphs of the face with index 'face_index' in
+ * 'file_name', computing them on first use, unless they are stored in
+ * 'cache_dir' (NULL for none). The table belongs to the cache and must
+ * not be freed. Returns NULL on error.
+ */
+const struct glyph_hash_table *glyph_hash_get_table(const char *cache_dir,
+    const char *file_name, int face_index);
+
+/* Get hash of the glyph 'idx', or 0 if it is not known */
+uint64_t glyph_hash_get(const struct glyph_hash_table *table,
+    unsigned long idx);
+
+#endif /* GLYPH_HASH_H_ */
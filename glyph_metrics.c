@@ -0,0 +1,140 @@
+/*
+ * glyph_metrics.c
+ *
+ * Glyph outlines are loaded without scaling and hinting, so the table does
+ * not depend on the size the font will be drawn at. FreeType faces cannot
+ * be shared between threads, so every worker opens its own face (from the
+ * shared mapping of the font file) and measures a contiguous slice of
+ * glyph indices.
+ */
+
+#include "glyph_metrics.h"
+#include "font_blob.h"
+#include "trace.h"
+
+#include <stdlib.h>
+#include <glib.h>
+
+/* Do not bother starting threads for small fonts */
+#define GLYPHS_PER_THREAD_MIN 1024
+
+struct metrics_job {
+  const char *file_name;
+  int face_index;
+  unsigned long first;
+  unsigned long last;
+  struct glyph_metrics *metrics;
+};
+
+/* Measure glyphs [job->first, job->last) using a private face */
+static gpointer measure_glyphs(gpointer data) {
+  struct metrics_job *job = data;
+  FT_Library library;
+  FT_Face face;
+  unsigned long i;
+  int64_t start = trace_begin();
+
+  trace_thread_name("glyph-metrics");
+  if (FT_Init_FreeType(&library))
+    return NULL;
+
+  if (font_blob_new_face(library, job->file_name, job->face_index, &face)) {
+    FT_Done_FreeType(library);
+    return NULL;
+  }
+
+  for (i = job->first; i < job->last; i++) {
+    struct glyph_metrics *m = &job->metrics[i];
+
+    /* FT_LOAD_NO_SCALE implies no hinting and no embedded bitmaps */
+    if (FT_Load_Glyph(face, i, FT_LOAD_NO_SCALE))
+      continue;
+
+    m->x_bearing = face->glyph->metrics.horiBearingX;
+    m->y_bearing = face->glyph->metrics.horiBearingY;
+    m->width = face->glyph->metrics.width;
+    m->height = face->glyph->metrics.height;
+    m->x_advance = face->glyph->metrics.horiAdvance;
+    m->valid = true;
+  }
+
+  FT_Done_Face(face);
+  FT_Done_FreeType(library);
+  trace_end("glyph_metrics", "measure glyphs", start);
+  return NULL;
+}
+
+struct glyph_metrics_table *glyph_metrics_load(const char *file_name,
+    int face_index, FT_Face face) {
+  struct glyph_metrics_table *table;
+  struct metrics_job *jobs;
+  GThread **threads;
+  unsigned int nthreads, i;
+  unsigned long chunk;
+
+  if (!FT_IS_SCALABLE(face) || face->num_glyphs <= 0 || !face->units_per_EM)
+    return NULL;
+
+  table = malloc(sizeof(*table));
+  if (!table)
+    return NULL;
+
+  table->num_glyphs = face->num_glyphs;
+  table->units_per_em = face->units_per_EM;
+  table->metrics = calloc(table->num_glyphs, sizeof(*table->metrics));
+  if (!table->metrics) {
+    free(table);
+    return NULL;
+  }
+
+  nthreads = g_get_num_processors();
+  if (nthreads > table->num_glyphs / GLYPHS_PER_THREAD_MIN)
+    nthreads = table->num_glyphs / GLYPHS_PER_THREAD_MIN;
+  if (nthreads < 1)
+    nthreads = 1;
+
+  jobs = calloc(nthreads, sizeof(*jobs));
+  threads = calloc(nthreads, sizeof(*threads));
+  if (!jobs || !threads) {
+    free(jobs);
+    free(threads);
+    glyph_metrics_free(table);
+    return NULL;
+  }
+
+  chunk = (table->num_glyphs + nthreads - 1) / nthreads;
+  for (i = 0; i < nthreads; i++) {
+    jobs[i].file_name = file_name;
+    jobs[i].face_index = face_index;
+    jobs[i].first = i * chunk;
+    jobs[i].last = MIN((i + 1) * chunk, table->num_glyphs);
+    jobs[i].metrics = table->metrics;
+  }
+
+  /* The calling thread measures the first slice itself */
+  for (i = 1; i < nthreads; i++)
+    threads[i] = g_thread_new("glyph-metrics", measure_glyphs, &jobs[i]);
+  measure_glyphs(&jobs[0]);
+  for (i = 1; i < nthreads; i++)
+    g_thread_join(threads[i]);
+
+  free(threads);
+  free(jobs);
+  return table;
+}
+
+const struct glyph_metrics *glyph_metrics_get(
+    const struct glyph_metrics_table *table, unsigned long idx) {
+  if (!table || idx >= table->num_glyphs || !table->metrics[idx].valid)
+    return NULL;
+
+  return &table->metrics[idx];
+}
+
+void glyph_metrics_free(struct glyph_metrics_table *table) {
+  if (!table)
+    return;
+
+  free(table->metrics);
+  free(table);
+}
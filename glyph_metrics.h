@@ -0,0 +1,47 @@
+/*
+ * glyph_metrics.h
+ *
+ * Per-face table of hinting-free glyph metrics, measured once in bulk
+ * so that glyphs can be positioned without asking cairo for extents.
+ */
+
+#ifndef GLYPH_METRICS_H_
+#define GLYPH_METRICS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+/* Metrics of a single glyph in font units (unscaled, unhinted) */
+struct glyph_metrics {
+  int32_t x_bearing;
+  int32_t y_bearing;
+  int32_t width;
+  int32_t height;
+  int32_t x_advance;
+  bool valid;
+};
+
+struct glyph_metrics_table {
+  unsigned long num_glyphs;
+  unsigned int units_per_em;
+  struct glyph_metrics *metrics;
+};
+
+/*
+ * Measure all glyphs of the face with index 'face_index' in 'file_name'.
+ * 'face' should be the already opened face; it is only used for its
+ * global properties, glyphs are loaded by worker threads using their
+ * own faces. Returns NULL if the font is not scalable or on error.
+ */
+struct glyph_metrics_table *glyph_metrics_load(const char *file_name,
+    int face_index, FT_Face face);
+
+/* Get metrics of the glyph 'idx', or NULL if they are not known */
+const struct glyph_metrics *glyph_metrics_get(
+    const struct glyph_metrics_table *table, unsigned long idx);
+
+void glyph_metrics_free(struct glyph_metrics_table *table);
+
+#endif /* GLYPH_METRICS_H_ */
@@ -0,0 +1,3962 @@
+/* Copyright © 2007-2010 Євгеній Мещеряков <eugen@debian.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_SFNT_NAMES_H
+#include FT_TYPE1_TABLES_H
+#include <cairo.h>
+#include <cairo-ft.h>
+#include <cairo-pdf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <pango/pangocairo.h>
+#include <pango/pangofc-fontmap.h>
+#include <fontconfig/fontconfig.h>
+#include <math.h>
+#include <libintl.h>
+#include <errno.h>
+#include <sys/stat.h>
+
+#include "libfntsample.h"
+#include "unicode_blocks.h"
+#include "ucd_xml_reader.h"
+#include "glyph_metrics.h"
+#include "font_cache.h"
+#include "font_blob.h"
+#include "glyph_hash.h"
+#include "svg_pages.h"
+#include "trace.h"
+#include "config.h"
+
+#define _(str)	dgettext(PACKAGE, str)
+#define N_(str)	(str)
+
+#define A4_WIDTH	FNTSAMPLE_PAGE_WIDTH
+#define A4_HEIGHT	FNTSAMPLE_PAGE_HEIGHT
+
+#define xmin_border	(72.0/1.5)
+#define ymin_border	(72.0)
+/* Chart pages have 16x16 cells by default, see fntsample_set_grid() */
+#define DEFAULT_GRID_SIZE	16
+#define MAX_GRID_SIZE	64
+
+#define CELL_X(ctx, x_min, N)	((x_min) + (ctx)->cell_width * ((N) / (ctx)->grid_rows))
+#define CELL_Y(ctx, N)	(ymin_border + (ctx)->cell_height * ((N) % (ctx)->grid_rows))
+
+/* Levels of outline entries: the font and Unicode blocks (or planes) */
+#define N_OUTLINE_LEVELS	2
+
+struct range {
+  uint32_t first;
+  uint32_t last;
+  bool include;
+  struct range *next;
+};
+
+struct label_font {
+  char *file_name;
+  struct label_font *next;
+};
+
+struct fntsample_style {
+  const char * const name;
+  const char * const default_val;
+};
+
+static const struct fntsample_style styles[] = {
+    { "header-font", "Sans Bold 12" }, { "font-name-font", "Serif Bold 12" }, {
+        "table-numbers-font", "Sans 10" }, { "cell-numbers-font", "Mono 8" }, {
+        "overview-font", "Sans 5" }, { NULL, NULL } };
+
+#define N_STYLES	(G_N_ELEMENTS(styles) - 1)
+
+struct fntsample_context {
+  const char *name; /* prefix for error messages */
+
+  /* Fonts to render */
+  char *font_file_name;
+  int font_index;
+  int font_instance; /* named instance of a variable font, 0 for none */
+  char *other_font_file_name;
+  int other_index;
+
+  /* Output options */
+  struct range *ranges;
+  struct range *last_range;
+  char *style_vals[N_STYLES];
+  bool compact_output;
+  int compact_threshold; /* percent of block covered by the font */
+  bool highlight_changed;
+  enum fntsample_overview overview;
+  char *cache_dir; /* see fntsample_set_cache_dir() */
+  unsigned int grid_columns; /* cells of chart pages, see fntsample_set_grid() */
+  unsigned int grid_rows;
+  double cell_width;
+  double cell_height;
+  fntsample_outline_func outline;
+  void *outline_data;
+  fntsample_progress_func progress;
+  void *progress_data;
+  int pages_done; /* pages finished by the current rendering */
+  bool failed; /* memory ran out during the current rendering */
+  int first_page; /* range of pages to draw, see fntsample_set_pages() */
+  int last_page;
+  bool page_skipped; /* the current page is outside of the range */
+  char *pending_outline[N_OUTLINE_LEVELS]; /* see range_outline() */
+  int64_t page_start; /* start of the trace span of the current page */
+
+  /* The page being drawn, see set_page_info() */
+  const char *page_type;
+  const char *page_block;
+  unsigned long page_first;
+  unsigned long page_last;
+
+  /* Pages are listed to dry_run_out instead of drawn, see fntsample_plan() */
+  FILE *dry_run_out;
+  enum fntsample_report_format dry_run_format;
+  struct dry_run_outline *dry_run_outline; /* entries of the current page */
+  size_t dry_run_outline_len;
+  size_t dry_run_outline_size;
+
+  /* Label fonts */
+  struct label_font *label_fonts;
+  struct label_font *last_label_font;
+  const struct label_font *loaded_label_fonts; /* fonts in font_map */
+  PangoFontMap *font_map;
+  PangoContext *pango_context;
+  PangoFontDescription *header_font;
+  PangoFontDescription *font_name_font;
+  PangoFontDescription *table_numbers_font;
+  PangoFontDescription *grid_numbers_font; /* table numbers scaled to the grid */
+  PangoFontDescription *cell_numbers_font;
+  PangoFontDescription *overview_font;
+
+  /* UCD data, the file it was loaded from and fonts for drawing it */
+  struct ucd_data *ucd;
+  struct stat ucd_stat;
+  PangoFontDescription *notice_line_font;
+  PangoFontDescription *block_header_font;
+  PangoFontDescription *subheader_font;
+  PangoFontDescription *other_font;
+  struct ascii_font *ascii_fonts; /* see get_ascii_font() */
+  unsigned int n_ascii_fonts;
+
+  /*
+   * UCD annotations do not depend on the instance of a variable font, but
+   * on its character map. They are laid out for the first instance and
+   * replayed for the others, see fntsample_render_instances().
+   */
+  struct ucd_run *ucd_runs;
+  size_t ucd_runs_len;
+  size_t ucd_runs_size;
+  size_t ucd_runs_pos; /* next run to replay */
+  bool ucd_recording;
+
+  /* State of the current rendering */
+  FT_Library library;
+  double cell_label_offset;
+  double cell_glyph_bot_offset;
+  double glyph_baseline_offset;
+
+  /*
+   * Metrics of all glyphs of the font and scale from font units to points.
+   * The metrics belong to font_cache, if the cache directory is set.
+   */
+  struct font_cache *font_cache;
+  struct glyph_metrics_table *glyph_metrics;
+  double glyph_metrics_scale;
+
+  /* Outline hashes of both fonts, if changed glyphs are highlighted */
+  const struct glyph_hash_table *glyph_hashes;
+  const struct glyph_hash_table *other_glyph_hashes;
+
+  /* Pages are written to separate SVG files, NULL for a single surface */
+  struct svg_pages *svg_pages;
+
+  /*
+   * Recorded static parts of the pages, painted on every page: grids by
+   * number of columns (with and without row numbers), and the font name
+   * of the header.
+   */
+  cairo_pattern_t *grid_templates[2][MAX_GRID_SIZE + 1];
+  cairo_pattern_t *header_template;
+  char *header_template_name;
+
+  /*
+   * Characters of the font in the output range. The character map is the
+   * same for all instances of a variable font, so it is enumerated once.
+   */
+  struct plan_char *plan;
+  size_t plan_len;
+  size_t plan_pos; /* position of the last returned character */
+  bool plan_valid;
+};
+
+/* Outline entry of a page listed by the dry run */
+struct dry_run_outline {
+  int level;
+  char *text;
+};
+
+/*
+ * Piece of UCD annotations laid out for the first of several instances,
+ * see replay_ucd_data()
+ */
+enum ucd_run_kind {
+  UCD_RUN_BLOCK,  /* start of the annotations of a block */
+  UCD_RUN_LAYOUT, /* Pango layout */
+  UCD_RUN_GLYPHS, /* text drawn by draw_ascii_text() */
+  UCD_RUN_SAMPLE, /* character drawn with the font */
+  UCD_RUN_PAGE    /* end of a page */
+};
+
+struct ucd_run {
+  enum ucd_run_kind kind;
+  double x, y;
+  PangoLayout *layout;
+  cairo_scaled_font_t *font; /* one of ascii_fonts */
+  cairo_glyph_t *glyphs;
+  int n_glyphs;
+  unsigned long index; /* glyph of the sample */
+  double height; /* height of the sample */
+  const struct ucd_block *block;
+  FT_ULong first, last; /* characters of the page */
+};
+
+/* Character of the font, see get_next_char() */
+struct plan_char {
+  FT_ULong charcode;
+  FT_UInt idx;
+};
+
+/*
+ * Check if character with the given code belongs
+ * to output range specified by the user.
+ */
+static bool in_range(const struct fntsample_context *ctx, uint32_t c) {
+  bool in = ctx->ranges ? (!ctx->ranges->include) : 1;
+  struct range *r;
+
+  for (r = ctx->ranges; r; r = r->next) {
+    if ((c >= r->first) && (c <= r->last))
+      in = r->include;
+  }
+  return in;
+}
+
+/*
+ * Face index of the font for FreeType, with the named instance
+ * in the upper 16 bits.
+ */
+static FT_Long font_face_index(const struct fntsample_context *ctx) {
+  return ctx->font_index | ((FT_Long) ctx->font_instance << 16);
+}
+
+/*
+ * Report that memory ran out. The library does not exit: the error is
+ * kept in the context, drawing stops (see drawing_done()) and the
+ * rendering returns FNTSAMPLE_ERROR.
+ */
+static void out_of_memory(struct fntsample_context *ctx) {
+  if (!ctx->failed)
+    fprintf(stderr, _("%s: out of memory\n"), ctx->name);
+  ctx->failed = true;
+}
+
+static int add_plan_char(struct fntsample_context *ctx, size_t *size,
+    FT_ULong charcode, FT_UInt idx) {
+  if (!in_range(ctx, charcode))
+    return 0;
+
+  if (ctx->plan_len == *size) {
+    struct plan_char *plan = realloc(ctx->plan, *size * 2 * sizeof(*plan));
+
+    if (!plan)
+      return -1;
+    ctx->plan = plan;
+    *size *= 2;
+  }
+  ctx->plan[ctx->plan_len].charcode = charcode;
+  ctx->plan[ctx->plan_len].idx = idx;
+  ctx->plan_len++;
+  return 0;
+}
+
+/*
+ * Collect all characters of the face in the output range, from the font
+ * cache if it is loaded. If memory runs out, the plan is left empty.
+ */
+static void build_plan(struct fntsample_context *ctx, FT_Face face) {
+  size_t size = 1024;
+  FT_ULong charcode;
+  FT_UInt idx;
+  int status = 0;
+
+  free(ctx->plan);
+  ctx->plan = malloc(size * sizeof(*ctx->plan));
+  ctx->plan_len = 0;
+  ctx->plan_pos = 0;
+  if (!ctx->plan) {
+    out_of_memory(ctx);
+    return;
+  }
+
+  if (ctx->font_cache) {
+    unsigned long i;
+
+    for (i = 0; i < ctx->font_cache->num_chars && !status; i++)
+      status = add_plan_char(ctx, &size, ctx->font_cache->chars[i].charcode,
+          ctx->font_cache->chars[i].idx);
+  }
+  else {
+    for (charcode = FT_Get_First_Char(face, &idx); idx && !status;
+        charcode = FT_Get_Next_Char(face, charcode, &idx))
+      status = add_plan_char(ctx, &size, charcode, idx);
+  }
+
+  if (status) {
+    free(ctx->plan);
+    ctx->plan = NULL;
+    ctx->plan_len = 0;
+    out_of_memory(ctx);
+    return;
+  }
+
+  ctx->plan_valid = true;
+}
+
+/*
+ * Get glyph index for the next glyph from the given font face, that
+ * represents character from output range specified by the user.
+ *
+ * Returns character code, updates 'idx'.
+ * 'idx' can became 0 if there are no more glyphs.
+ */
+static FT_ULong get_next_char(struct fntsample_context *ctx, FT_Face face,
+    FT_ULong charcode, FT_UInt *idx) {
+  size_t pos = ctx->plan_pos, lo, hi;
+
+  if (!ctx->plan_valid)
+    build_plan(ctx, face);
+
+  /* Usually the character returned last time is given */
+  if (pos < ctx->plan_len && ctx->plan[pos].charcode == charcode)
+    pos++;
+  else {
+    lo = 0;
+    hi = ctx->plan_len;
+    while (lo < hi) {
+      size_t mid = lo + (hi - lo) / 2;
+
+      if (ctx->plan[mid].charcode <= charcode)
+        lo = mid + 1;
+      else hi = mid;
+    }
+    pos = lo;
+  }
+
+  if (pos >= ctx->plan_len) {
+    *idx = 0;
+    return 0;
+  }
+
+  ctx->plan_pos = pos;
+  *idx = ctx->plan[pos].idx;
+  return ctx->plan[pos].charcode;
+}
+
+/*
+ * Locate first character from the given font face that belongs
+ * to the user-specified output range.
+ *
+ * Returns character code, updates 'idx' with glyph index.
+ * Glyph index can became 0 if there are no matching glyphs in the font.
+ */
+static FT_ULong get_first_char(struct fntsample_context *ctx, FT_Face face,
+    FT_UInt *idx) {
+  if (!ctx->plan_valid)
+    build_plan(ctx, face);
+
+  if (!ctx->plan_len) {
+    *idx = 0;
+    return 0;
+  }
+
+  ctx->plan_pos = 0;
+  *idx = ctx->plan[0].idx;
+  return ctx->plan[0].charcode;
+}
+
+/*
+ * Create Pango layout for the given text.
+ * Updates 'r' with text extents.
+ * Returned layout should be freed using g_object_unref().
+ */
+static PangoLayout *layout_text(struct fntsample_context *ctx,
+    PangoFontDescription *ftdesc, const char *text, PangoRectangle *r) {
+  PangoLayout *layout;
+
+  layout = pango_layout_new(ctx->pango_context);
+  pango_layout_set_font_description(layout, ftdesc);
+  pango_layout_set_text(layout, text, -1);
+  pango_layout_get_extents(layout, r, NULL);
+
+  return layout;
+}
+
+/*
+ * Locate unicode block that contains given character code.
+ * Returns this block or NULL if not found.
+ */
+static const struct unicode_block *get_unicode_block(unsigned long charcode) {
+  const struct unicode_block *block;
+
+  for (block = unicode_blocks; block->name; block++) {
+    if ((charcode >= block->start) && (charcode <= block->end))
+      return block;
+  }
+  return NULL;
+}
+
+/*
+ * Check if the given character code belongs to the given Unicode block.
+ */
+static bool is_in_block(unsigned long charcode,
+    const struct unicode_block *block) {
+  return ((charcode >= block->start) && (charcode <= block->end));
+}
+
+/*
+ * Is the page (counted from 1 in the whole document) in the range set with
+ * fntsample_set_pages()? The dry run lists all pages.
+ */
+static bool page_wanted(const struct fntsample_context *ctx, int page) {
+  return !ctx->first_page || ctx->dry_run_out
+      || (page >= ctx->first_page && (!ctx->last_page || page <= ctx->last_page));
+}
+
+/* Should drawing stop: memory ran out, or all pages of the range are done? */
+static bool drawing_done(const struct fntsample_context *ctx) {
+  return ctx->failed || (ctx->last_page && !ctx->dry_run_out
+      && ctx->pages_done >= ctx->last_page);
+}
+
+/*
+ * Pass outline entries kept by range_outline() at the first page of the
+ * output, if their level is lower than 'level'. Other entries are dropped.
+ */
+static void flush_outline(struct fntsample_context *ctx, int level) {
+  int i;
+
+  for (i = 0; i < N_OUTLINE_LEVELS; i++) {
+    if (ctx->pending_outline[i] && i < level)
+      ctx->outline(ctx->outline_data, i, 1, ctx->pending_outline[i]);
+    free(ctx->pending_outline[i]);
+    ctx->pending_outline[i] = NULL;
+  }
+}
+
+/*
+ * Pass outline entry of a document drawn only partially: pages are counted
+ * from the start of the output. The last entries before the range are
+ * kept, so that the first page is still found under its font and block.
+ */
+static void range_outline(struct fntsample_context *ctx, int level, int page,
+    const char *text) {
+  int i;
+
+  if (page < ctx->first_page) {
+    for (i = level; i < N_OUTLINE_LEVELS; i++) {
+      free(ctx->pending_outline[i]);
+      ctx->pending_outline[i] = NULL;
+    }
+    ctx->pending_outline[level] = strdup(text);
+    if (!ctx->pending_outline[level])
+      out_of_memory(ctx);
+  }
+  else if (page_wanted(ctx, page)) {
+    flush_outline(ctx, level);
+    ctx->outline(ctx->outline_data, level, page - ctx->first_page + 1, text);
+  }
+}
+
+/*
+ * Pass outline information to the user, if requested. The dry run lists
+ * the entries with the page they point to.
+ */
+static void outline(struct fntsample_context *ctx, int level, int page,
+    const char *text) {
+  if (ctx->outline) {
+    if (ctx->first_page && !ctx->dry_run_out)
+      range_outline(ctx, level, page, text);
+    else ctx->outline(ctx->outline_data, level, page, text);
+  }
+
+  if (ctx->dry_run_out) {
+    struct dry_run_outline *entry;
+    char *copy = strdup(text);
+
+    if (!copy) {
+      out_of_memory(ctx);
+      return;
+    }
+
+    if (ctx->dry_run_outline_len == ctx->dry_run_outline_size) {
+      size_t size = ctx->dry_run_outline_size ? ctx->dry_run_outline_size * 2 : 4;
+
+      entry = realloc(ctx->dry_run_outline, size * sizeof(*entry));
+      if (!entry) {
+        free(copy);
+        out_of_memory(ctx);
+        return;
+      }
+      ctx->dry_run_outline = entry;
+      ctx->dry_run_outline_size = size;
+    }
+    entry = &ctx->dry_run_outline[ctx->dry_run_outline_len++];
+    entry->level = level;
+    entry->text = copy;
+  }
+}
+
+/*
+ * Describe the page being drawn: its type, block and the span of
+ * character codes shown on it (-1UL if none).
+ */
+static void set_page_info(struct fntsample_context *ctx, const char *type,
+    const char *block, unsigned long first, unsigned long last) {
+  ctx->page_type = type;
+  ctx->page_block = block;
+  ctx->page_first = first;
+  ctx->page_last = last;
+}
+
+static void print_json_string(FILE *out, const char *s) {
+  fputc('"', out);
+  for (; *s; s++) {
+    unsigned char c = *s;
+
+    if (c == '"' || c == '\\')
+      fprintf(out, "\\%c", c);
+    else if (c < 0x20)
+      fprintf(out, "\\u%04x", c);
+    else fputc(c, out);
+  }
+  fputc('"', out);
+}
+
+static void print_csv_string(FILE *out, const char *s) {
+  fputc('"', out);
+  for (; *s; s++) {
+    if (*s == '"')
+      fputc('"', out);
+    fputc(*s, out);
+  }
+  fputc('"', out);
+}
+
+static void print_plan_code(FILE *out, unsigned long charcode,
+    enum fntsample_report_format format) {
+  if (charcode != -1UL)
+    fprintf(out, format == FNTSAMPLE_REPORT_JSON ? "\"U+%04lX\"" : "U+%04lX",
+        charcode);
+  else if (format == FNTSAMPLE_REPORT_JSON)
+    fputs("null", out);
+}
+
+/*
+ * List the finished page and the outline entries pointing to it, as an
+ * element of the JSON array or a CSV row.
+ */
+static void print_plan_page(struct fntsample_context *ctx) {
+  enum fntsample_report_format format = ctx->dry_run_format;
+  FILE *out = ctx->dry_run_out;
+  size_t i;
+
+  if (format == FNTSAMPLE_REPORT_JSON) {
+    fprintf(out, "%s\n    {\"page\": %d, \"type\": ", ctx->pages_done ? "," : "",
+        ctx->pages_done + 1);
+    print_json_string(out, ctx->page_type);
+    fputs(", \"block\": ", out);
+    print_json_string(out, ctx->page_block);
+    fputs(", \"first\": ", out);
+    print_plan_code(out, ctx->page_first, format);
+    fputs(", \"last\": ", out);
+    print_plan_code(out, ctx->page_last, format);
+    fputs(", \"outline\": [", out);
+    for (i = 0; i < ctx->dry_run_outline_len; i++) {
+      fprintf(out, "%s{\"level\": %d, \"text\": ", i ? ", " : "",
+          ctx->dry_run_outline[i].level);
+      print_json_string(out, ctx->dry_run_outline[i].text);
+      fputc('}', out);
+    }
+    fputs("]}", out);
+  }
+  else {
+    fprintf(out, "%d,%s,", ctx->pages_done + 1, ctx->page_type);
+    print_csv_string(out, ctx->page_block);
+    fputc(',', out);
+    print_plan_code(out, ctx->page_first, format);
+    fputc(',', out);
+    print_plan_code(out, ctx->page_last, format);
+    fputc(',', out);
+    /* Entries are LEVEL:TEXT separated by semicolons, in one field */
+    fputc('"', out);
+    for (i = 0; i < ctx->dry_run_outline_len; i++) {
+      const char *c;
+
+      fprintf(out, "%s%d:", i ? ";" : "", ctx->dry_run_outline[i].level);
+      for (c = ctx->dry_run_outline[i].text; *c; c++) {
+        if (*c == '"')
+          fputc('"', out);
+        fputc(*c, out);
+      }
+    }
+    fputs("\"\n", out);
+  }
+
+  for (i = 0; i < ctx->dry_run_outline_len; i++)
+    free(ctx->dry_run_outline[i].text);
+  ctx->dry_run_outline_len = 0;
+}
+
+/*
+ * Pass progress information to the user, if requested.
+ */
+static void progress(struct fntsample_context *ctx,
+    enum fntsample_progress_event event, const char *block) {
+  if (ctx->progress)
+    ctx->progress(ctx->progress_data, event, ctx->pages_done, block);
+}
+
+/*
+ * Start recording a page template, drawn with the returned context.
+ */
+static cairo_t *template_begin(void) {
+  cairo_rectangle_t page = { 0, 0, A4_WIDTH, A4_HEIGHT };
+  cairo_surface_t *surface;
+  cairo_t *cr;
+
+  surface = cairo_recording_surface_create(CAIRO_CONTENT_COLOR_ALPHA, &page);
+  cr = cairo_create(surface);
+  cairo_surface_destroy(surface);
+  return cr;
+}
+
+/*
+ * Finish recording of the template, returns pattern to paint it.
+ */
+static cairo_pattern_t *template_end(cairo_t *cr) {
+  cairo_pattern_t *pattern = cairo_pattern_create_for_surface(
+      cairo_get_target(cr));
+
+  cairo_destroy(cr);
+  return pattern;
+}
+
+static void paint_template(cairo_t *cr, cairo_pattern_t *pattern) {
+  cairo_save(cr);
+  cairo_set_source(cr, pattern);
+  cairo_paint(cr);
+  cairo_restore(cr);
+}
+
+/*
+ * Templates have to be recorded again when label fonts change.
+ */
+static void free_templates(struct fntsample_context *ctx) {
+  unsigned int i, j;
+
+  for (i = 0; i < G_N_ELEMENTS(ctx->grid_templates); i++) {
+    for (j = 0; j < G_N_ELEMENTS(ctx->grid_templates[i]); j++) {
+      if (ctx->grid_templates[i][j])
+        cairo_pattern_destroy(ctx->grid_templates[i][j]);
+      ctx->grid_templates[i][j] = NULL;
+    }
+  }
+
+  if (ctx->header_template)
+    cairo_pattern_destroy(ctx->header_template);
+  ctx->header_template = NULL;
+  free(ctx->header_template_name);
+  ctx->header_template_name = NULL;
+}
+
+static void draw_font_name(struct fntsample_context *ctx, cairo_t *cr,
+    const char *face_name) {
+  PangoLayout *layout;
+  PangoRectangle r;
+
+  layout = layout_text(ctx, ctx->font_name_font, face_name, &r);
+  cairo_move_to(cr, (A4_WIDTH - (double) r.width / PANGO_SCALE) / 2.0, 30.0);
+  pango_cairo_show_layout_line(cr, pango_layout_get_line_readonly(layout, 0));
+  g_object_unref(layout);
+}
+
+/*
+ * Draw header of a page.
+ * Header shows font name and current Unicode block.
+ * The font name is recorded once and painted on the following pages.
+ * Pages of separate SVG files are drawn directly, they are replayed by
+ * the page writer threads.
+ */
+static void draw_header(struct fntsample_context *ctx, cairo_t *cr,
+    const char *face_name, const char *block_name) {
+  PangoLayout *layout;
+  PangoRectangle r;
+
+  if (ctx->svg_pages)
+    draw_font_name(ctx, cr, face_name);
+  else {
+    if (!ctx->header_template || strcmp(ctx->header_template_name, face_name)) {
+      cairo_t *tcr;
+
+      free(ctx->header_template_name);
+      if (ctx->header_template)
+        cairo_pattern_destroy(ctx->header_template);
+      ctx->header_template = NULL;
+      ctx->header_template_name = strdup(face_name);
+      if (!ctx->header_template_name)
+        out_of_memory(ctx);
+      else {
+        tcr = template_begin();
+        draw_font_name(ctx, tcr, face_name);
+        ctx->header_template = template_end(tcr);
+      }
+    }
+    if (ctx->header_template)
+      paint_template(cr, ctx->header_template);
+    else draw_font_name(ctx, cr, face_name);
+  }
+
+  layout = layout_text(ctx, ctx->header_font, block_name, &r);
+  cairo_move_to(cr, (A4_WIDTH - (double) r.width / PANGO_SCALE) / 2.0, 50.0);
+  pango_cairo_show_layout_line(cr, pango_layout_get_line_readonly(layout, 0));
+  g_object_unref(layout);
+}
+
+/*
+ * Highlight the cell with given coordinates.
+ * Used to highlight new glyphs.
+ */
+static void highlight_cell(struct fntsample_context *ctx, cairo_t *cr,
+    double x, double y, double r, double g, double b) {
+  cairo_save(cr);
+  cairo_set_source_rgb(cr, r, g, b);
+  cairo_rectangle(cr, x, y, ctx->cell_width, ctx->cell_height);
+  cairo_fill(cr);
+  cairo_restore(cr);
+}
+
+/*
+ * Highlight the cell if the character is missing in the other font, or,
+ * if requested, if its glyph differs from the glyph in the other font.
+ */
+static void highlight_changes(struct fntsample_context *ctx, cairo_t *cr,
+    double x, double y, unsigned long charcode, FT_UInt idx,
+    FT_Face ft_other_face) {
+  FT_UInt other_idx;
+  uint64_t hash, other_hash;
+
+  if (!ft_other_face)
+    return;
+
+  other_idx = FT_Get_Char_Index(ft_other_face, charcode);
+  if (!other_idx) {
+    highlight_cell(ctx, cr, x, y, 1.0, 1.0, 0.6);
+    return;
+  }
+
+  if (!ctx->glyph_hashes || !ctx->other_glyph_hashes)
+    return;
+
+  hash = glyph_hash_get(ctx->glyph_hashes, idx);
+  other_hash = glyph_hash_get(ctx->other_glyph_hashes, other_idx);
+  if (hash && other_hash && hash != other_hash)
+    highlight_cell(ctx, cr, x, y, 0.7, 0.85, 1.0);
+}
+
+/*
+ * Draw glyphs of the font, or just reference them from the glyph library
+ * when writing separate SVG pages.
+ */
+static void show_glyphs(struct fntsample_context *ctx, cairo_t *cr,
+    const cairo_glyph_t *glyphs, int num_glyphs) {
+  cairo_matrix_t matrix;
+
+  if (ctx->page_skipped)
+    return;
+
+  if (!ctx->svg_pages) {
+    cairo_show_glyphs(cr, glyphs, num_glyphs);
+    return;
+  }
+
+  cairo_get_font_matrix(cr, &matrix);
+  svg_pages_add_glyphs(ctx->svg_pages, glyphs, num_glyphs, &matrix);
+}
+
+/*
+ * Start the next page. Pages outside of the range set with
+ * fntsample_set_pages() are laid out as usual, but glyphs and text are
+ * not drawn (checked with page_skipped), and anything else is clipped
+ * away. Drawn pages of PDF output are labelled with their
+ * numbers in the whole document.
+ */
+static void begin_page(struct fntsample_context *ctx, cairo_t *cr) {
+  bool skip;
+
+  if (!ctx->first_page || ctx->dry_run_out)
+    return;
+
+  skip = !page_wanted(ctx, ctx->pages_done + 1);
+  if (skip != ctx->page_skipped) {
+    ctx->page_skipped = skip;
+    cairo_reset_clip(cr);
+    if (skip) {
+      cairo_rectangle(cr, 0, 0, 0, 0);
+      cairo_clip(cr);
+    }
+  }
+
+#if CAIRO_HAS_PDF_SURFACE && CAIRO_VERSION >= CAIRO_VERSION_ENCODE(1, 16, 0)
+  if (!skip && cairo_surface_get_type(cairo_get_target(cr))
+      == CAIRO_SURFACE_TYPE_PDF) {
+    char label[16];
+
+    snprintf(label, sizeof(label), "%d", ctx->pages_done + 1);
+    cairo_pdf_surface_set_page_label(cairo_get_target(cr), label);
+  }
+#endif
+}
+
+/*
+ * Finish the page. Separate SVG pages are drawn into groups, which are
+ * handed over to the page writer.
+ */
+static void show_page(struct fntsample_context *ctx, cairo_t *cr) {
+  if (ctx->dry_run_out)
+    print_plan_page(ctx);
+  else if (ctx->svg_pages) {
+    cairo_pattern_t *page = cairo_pop_group(cr);
+
+    if (ctx->page_skipped)
+      svg_pages_skip_page(ctx->svg_pages, page);
+    else svg_pages_end_page(ctx->svg_pages, page);
+  }
+  else if (!ctx->page_skipped)
+    cairo_show_page(cr);
+
+  /* Entries before the range point to its first page */
+  if (!ctx->page_skipped)
+    flush_outline(ctx, N_OUTLINE_LEVELS);
+
+  ctx->pages_done++;
+  if (ctx->page_start) {
+    char name[32];
+
+    snprintf(name, sizeof(name), "page %d", ctx->pages_done);
+    trace_end("page", name, ctx->page_start);
+  }
+  ctx->page_start = trace_begin();
+  begin_page(ctx, cr);
+  if (ctx->svg_pages)
+    cairo_push_group(cr);
+  progress(ctx, FNTSAMPLE_PROGRESS_PAGE, NULL);
+}
+
+/*
+ * Try to place glyph with the given index at the middle of the cell.
+ * Uses the glyph metrics table, cairo is asked only for glyphs that
+ * are missing there (e.g. in bitmap fonts).
+ * Changes argument 'glyph'
+ */
+static void position_glyph(struct fntsample_context *ctx, cairo_t *cr, double x,
+    double y, unsigned long idx, cairo_glyph_t *glyph) {
+  const struct glyph_metrics *metrics = glyph_metrics_get(ctx->glyph_metrics,
+      idx);
+  cairo_text_extents_t extents;
+
+  *glyph = (cairo_glyph_t) {idx, 0, 0};
+
+  if (metrics) {
+    extents.width = metrics->width * ctx->glyph_metrics_scale;
+    extents.x_bearing = metrics->x_bearing * ctx->glyph_metrics_scale;
+  }
+  else cairo_glyph_extents(cr, glyph, 1, &extents);
+
+  glyph->x += x + (ctx->cell_width - extents.width) / 2.0 - extents.x_bearing;
+  glyph->y += y + ctx->glyph_baseline_offset;
+}
+
+/*
+ * Draw the part of the table grid that is the same on all pages with the
+ * same number of columns: lines, and optionally row numbers.
+ */
+static void draw_grid_lines(struct fntsample_context *ctx, cairo_t *cr,
+    unsigned int x_cells, bool numbers) {
+  unsigned int i;
+  double x_min = (A4_WIDTH - x_cells * ctx->cell_width) / 2;
+  double x_max = (A4_WIDTH + x_cells * ctx->cell_width) / 2;
+  char buf[9];
+  PangoLayout *layout;
+  PangoRectangle r;
+
+#define TABLE_H (A4_HEIGHT - ymin_border * 2)
+  cairo_set_line_width(cr, 1.0);
+  cairo_rectangle(cr, x_min, ymin_border, x_max - x_min, TABLE_H);
+  cairo_move_to(cr, x_min, ymin_border);
+  cairo_line_to(cr, x_min, ymin_border - 15.0);
+  cairo_move_to(cr, x_max, ymin_border);
+  cairo_line_to(cr, x_max, ymin_border - 15.0);
+  cairo_stroke(cr);
+
+  cairo_set_line_width(cr, 0.5);
+  /* draw horizontal lines */
+  for (i = 1; i < ctx->grid_rows; i++) {
+    cairo_move_to(cr, x_min, ymin_border + i * ctx->cell_height);
+    cairo_line_to(cr, x_max, ymin_border + i * ctx->cell_height);
+  }
+
+  /* draw vertical lines */
+  for (i = 1; i < x_cells; i++) {
+    cairo_move_to(cr, x_min + i * ctx->cell_width, ymin_border);
+    cairo_line_to(cr, x_min + i * ctx->cell_width, A4_HEIGHT - ymin_border);
+  }
+  cairo_stroke(cr);
+
+  if (!numbers)
+    return;
+
+  /* draw glyph numbers: the last digit, or the offset in the column */
+  for (i = 0; i < ctx->grid_rows; i++) {
+    snprintf(buf, sizeof(buf), ctx->grid_rows > 16 ? "%02X" : "%X", i);
+    layout = layout_text(ctx, ctx->grid_numbers_font, buf, &r);
+    cairo_move_to(cr, x_min - (double) PANGO_RBEARING(r) / PANGO_SCALE - 5.0,
+        ymin_border + (i + 0.5) * ctx->cell_height
+            + (double) PANGO_DESCENT(r) / PANGO_SCALE / 2);
+    pango_cairo_show_layout_line(cr, pango_layout_get_line_readonly(layout, 0));
+    cairo_move_to(cr, x_min + x_cells * ctx->cell_width + 5.0,
+        ymin_border + (i + 0.5) * ctx->cell_height
+            + (double) PANGO_DESCENT(r) / PANGO_SCALE / 2);
+    pango_cairo_show_layout_line(cr, pango_layout_get_line_readonly(layout, 0));
+    g_object_unref(layout);
+  }
+}
+
+/*
+ * Draw table grid, optionally with row and column numbers. Static part of
+ * the grid is recorded once for every number of columns.
+ */
+static void draw_grid(struct fntsample_context *ctx, cairo_t *cr,
+    unsigned int x_cells, unsigned long block_start, bool numbers) {
+  cairo_pattern_t **template = &ctx->grid_templates[numbers][x_cells];
+  unsigned int i;
+  double x_min = (A4_WIDTH - x_cells * ctx->cell_width) / 2;
+  char buf[9];
+  PangoLayout *layout;
+  PangoRectangle r;
+
+  if (ctx->svg_pages)
+    draw_grid_lines(ctx, cr, x_cells, numbers);
+  else {
+    if (!*template) {
+      cairo_t *tcr = template_begin();
+
+      draw_grid_lines(ctx, tcr, x_cells, numbers);
+      *template = template_end(tcr);
+    }
+    paint_template(cr, *template);
+  }
+
+  if (!numbers)
+    return;
+
+  /*
+   * Columns of 16 cells are numbered by the code without its last digit,
+   * other columns by the code of their first cell.
+   */
+  for (i = 0; i < x_cells; i++) {
+    unsigned long code = block_start + i * ctx->grid_rows;
+
+    if (ctx->grid_rows == 16)
+      snprintf(buf, sizeof(buf), "%03lX", code / 16);
+    else snprintf(buf, sizeof(buf), "%04lX", code);
+    layout = layout_text(ctx, ctx->grid_numbers_font, buf, &r);
+    cairo_move_to(cr,
+        x_min + i * ctx->cell_width
+            + (ctx->cell_width - (double) r.width / PANGO_SCALE) / 2,
+        ymin_border - 5.0);
+    pango_cairo_show_layout_line(cr, pango_layout_get_line_readonly(layout, 0));
+    g_object_unref(layout);
+  }
+}
+
+/*
+ * Fill empty cell. Color of the fill depends on the character properties.
+ */
+static void fill_empty_cell(struct fntsample_context *ctx, cairo_t *cr,
+    double x, double y, unsigned long charcode) {
+  cairo_save(cr);
+  if (g_unichar_isdefined(charcode)) {
+    if (g_unichar_iscntrl(charcode))
+      cairo_set_source_rgb(cr, 0.0, 0.0, 0.5);
+    else cairo_set_source_rgb(cr, 0.5, 0.5, 0.5);
+  }
+  cairo_rectangle(cr, x, y, ctx->cell_width, ctx->cell_height);
+  cairo_fill(cr);
+  cairo_restore(cr);
+}
+
+/*
+ * Draw label with character code.
+ */
+static void draw_charcode(struct fntsample_context *ctx, cairo_t *cr, double x,
+    double y, FT_ULong charcode) {
+  char buf[9];
+  PangoLayout *layout;
+  PangoRectangle r;
+
+  snprintf(buf, sizeof(buf), "%04lX", charcode);
+  layout = layout_text(ctx, ctx->cell_numbers_font, buf, &r);
+  cairo_move_to(cr, x + (ctx->cell_width - (double) r.width / PANGO_SCALE) / 2.0,
+      y + ctx->cell_height - ctx->cell_label_offset);
+  pango_cairo_show_layout_line(cr, pango_layout_get_line_readonly(layout, 0));
+  g_object_unref(layout);
+}
+
+/*
+ * Draws tables for all characters in the given Unicode block.
+ * Use font described by face and ft_face. Start from character
+ * with given charcode (it should belong to the given Unicode
+ * block). After return 'charcode' equals the last character code
+ * of the block.
+ *
+ * Returns number of pages drawn.
+ */
+static int draw_unicode_block(struct fntsample_context *ctx, cairo_t *cr,
+    cairo_scaled_font_t *font, FT_Face ft_face, const char *fontname,
+    unsigned long *charcode, const struct unicode_block *block,
+    FT_Face ft_other_face) {
+  FT_UInt idx;
+  unsigned long prev_charcode;
+  unsigned long prev_cell;
+  unsigned long cells = ctx->grid_columns * ctx->grid_rows;
+  bool *filled_cells = malloc(cells * sizeof(*filled_cells));
+  cairo_glyph_t *glyphs = malloc(cells * sizeof(*glyphs));
+  int npages = 0;
+  int64_t start = trace_begin();
+
+  if (!filled_cells || !glyphs) {
+    free(filled_cells);
+    free(glyphs);
+    out_of_memory(ctx);
+    return 0;
+  }
+
+  idx = FT_Get_Char_Index(ft_face, *charcode);
+
+  do {
+    unsigned long offset = ((*charcode - block->start) / cells) * cells;
+    unsigned long tbl_start = block->start + offset;
+    unsigned long tbl_end = tbl_start + cells - 1 > block->end ?
+        block->end + 1 : tbl_start + cells;
+    unsigned int rows = (tbl_end - tbl_start + ctx->grid_rows - 1)
+        / ctx->grid_rows;
+    double x_min = (A4_WIDTH - rows * ctx->cell_width) / 2;
+    unsigned long i;
+    unsigned int nglyphs = 0;
+    /* pages out of range, and all pages of the dry run, are only counted */
+    bool draw = !ctx->page_skipped && !ctx->dry_run_out;
+
+    ctx->page_start = trace_begin();
+    cairo_save(cr);
+    if (draw)
+      draw_header(ctx, cr, fontname, block->name);
+    prev_cell = tbl_start - 1;
+
+    memset(filled_cells, '\0', cells * sizeof(*filled_cells));
+
+    cairo_set_scaled_font(cr, font);
+    /*
+     * Fill empty cells and calculate coordinates of the glyphs.
+     * Also highlight cells if needed.
+     */
+    do {
+      /* the current glyph position in the table */
+      int charpos = *charcode - tbl_start;
+
+      if (draw) {
+        /* fill empty cells before the current glyph */
+        for (i = prev_cell + 1; i < *charcode; i++) {
+          int pos = i - tbl_start;
+          fill_empty_cell(ctx, cr, CELL_X(ctx, x_min, pos), CELL_Y(ctx, pos),
+              i);
+        }
+
+        /* if it is new or changed glyph - highlight the cell */
+        highlight_changes(ctx, cr, CELL_X(ctx, x_min, charpos),
+            CELL_Y(ctx, charpos), *charcode, idx, ft_other_face);
+
+        /* For now just position glyphs. They will be shown later,
+         * to make output more efficient. */
+        position_glyph(ctx, cr, CELL_X(ctx, x_min, charpos),
+            CELL_Y(ctx, charpos), idx, &glyphs[nglyphs++]);
+      }
+
+      filled_cells[charpos] = true;
+
+      prev_charcode = *charcode;
+
+      prev_cell = *charcode;
+      *charcode = get_next_char(ctx, ft_face, *charcode, &idx);
+    } while (idx && (*charcode < tbl_end) && is_in_block(*charcode, block));
+
+    if (draw) {
+      /* Fill remaining empty cells */
+      for (i = prev_cell + 1; i < tbl_end; i++) {
+        int pos = i - tbl_start;
+        fill_empty_cell(ctx, cr, CELL_X(ctx, x_min, pos), CELL_Y(ctx, pos), i);
+      }
+
+      /* Show previously positioned glyphs */
+      show_glyphs(ctx, cr, glyphs, nglyphs);
+
+      for (i = 0; i < tbl_end - tbl_start; i++)
+        if (filled_cells[i])
+          draw_charcode(ctx, cr, CELL_X(ctx, x_min, i), CELL_Y(ctx, i),
+              i + tbl_start);
+
+      draw_grid(ctx, cr, rows, tbl_start, true);
+    }
+    npages++;
+    cairo_restore(cr);
+    set_page_info(ctx, "chart", block->name, tbl_start, tbl_end - 1);
+    show_page(ctx, cr);
+  } while (idx && is_in_block(*charcode, block) && !drawing_done(ctx));
+
+  free(filled_cells);
+  free(glyphs);
+  *charcode = prev_charcode;
+  trace_end("draw_unicode_block", block->name, start);
+  return npages;
+}
+
+/*
+ * Check if the font covers less than ctx->compact_threshold percent of the
+ * given block, starting from 'charcode'. Blocks that fit on one page
+ * are never considered sparse.
+ */
+static bool is_sparse_block(struct fntsample_context *ctx, FT_Face ft_face,
+    unsigned long charcode, const struct unicode_block *block) {
+  unsigned long size = block->end - block->start + 1;
+  unsigned long covered = 0;
+  FT_UInt idx = FT_Get_Char_Index(ft_face, charcode);
+
+  if (size <= ctx->grid_columns * ctx->grid_rows)
+    return false;
+
+  while (idx && is_in_block(charcode, block)) {
+    covered++;
+    charcode = get_next_char(ctx, ft_face, charcode, &idx);
+  }
+
+  return covered * 100 < size * ctx->compact_threshold;
+}
+
+/*
+ * Draws compact tables for the given (sparse) Unicode block. Only cells
+ * for characters present in the font are drawn, packed as many per page
+ * as the grid has cells, and every cell is labelled with its character
+ * code. Arguments and return value are the same as for
+ * draw_unicode_block(ctx).
+ */
+static int draw_compact_block(struct fntsample_context *ctx, cairo_t *cr,
+    cairo_scaled_font_t *font, FT_Face ft_face, const char *fontname,
+    unsigned long *charcode, const struct unicode_block *block,
+    FT_Face ft_other_face) {
+  FT_UInt idx;
+  unsigned long prev_charcode;
+  unsigned int cells = ctx->grid_columns * ctx->grid_rows;
+  unsigned long *codes = malloc(cells * sizeof(*codes));
+  FT_UInt *indices = malloc(cells * sizeof(*indices));
+  cairo_glyph_t *glyphs = malloc(cells * sizeof(*glyphs));
+  int npages = 0;
+  int64_t start = trace_begin();
+
+  if (!codes || !indices || !glyphs) {
+    free(codes);
+    free(indices);
+    free(glyphs);
+    out_of_memory(ctx);
+    return 0;
+  }
+
+  idx = FT_Get_Char_Index(ft_face, *charcode);
+
+  do {
+    unsigned int ncells = 0, columns, i;
+    double x_min;
+
+    ctx->page_start = trace_begin();
+
+    /* Collect characters for this page first, the table width depends on them */
+    do {
+      codes[ncells] = *charcode;
+      indices[ncells] = idx;
+      ncells++;
+
+      prev_charcode = *charcode;
+      *charcode = get_next_char(ctx, ft_face, *charcode, &idx);
+    } while (idx && ncells < cells && is_in_block(*charcode, block));
+
+    columns = (ncells + ctx->grid_rows - 1) / ctx->grid_rows;
+    x_min = (A4_WIDTH - columns * ctx->cell_width) / 2;
+
+    /* Pages out of range, and all pages of the dry run, are only counted */
+    if (!ctx->page_skipped && !ctx->dry_run_out) {
+      cairo_save(cr);
+      draw_header(ctx, cr, fontname, block->name);
+      cairo_set_scaled_font(cr, font);
+
+      for (i = 0; i < ncells; i++) {
+        highlight_changes(ctx, cr, CELL_X(ctx, x_min, i), CELL_Y(ctx, i),
+            codes[i], indices[i], ft_other_face);
+
+        position_glyph(ctx, cr, CELL_X(ctx, x_min, i), CELL_Y(ctx, i),
+            indices[i], &glyphs[i]);
+      }
+
+      show_glyphs(ctx, cr, glyphs, ncells);
+
+      for (i = 0; i < ncells; i++)
+        draw_charcode(ctx, cr, CELL_X(ctx, x_min, i), CELL_Y(ctx, i), codes[i]);
+
+      draw_grid(ctx, cr, columns, codes[0], false);
+      cairo_restore(cr);
+    }
+    npages++;
+    set_page_info(ctx, "compact", block->name, codes[0], codes[ncells - 1]);
+    show_page(ctx, cr);
+  } while (idx && is_in_block(*charcode, block) && !drawing_done(ctx));
+
+  free(codes);
+  free(indices);
+  free(glyphs);
+  *charcode = prev_charcode;
+  trace_end("draw_compact_block", block->name, start);
+  return npages;
+}
+
+/* =================================================================================== */
+/* Draw UCD comments.
+ *
+ * Author: Paweł Parafiński <ppablo28@gmail.com>
+ * This is an extension of the project available at: http://sourceforge.net/projects/fntsample/?source=dlp
+ * In this version UCD comments are drawn after each block.
+ */
+/* =================================================================================== */
+
+#define BLOCK_HEADER_X(hWidth)  (A4_WIDTH - hWidth / PANGO_SCALE) / 2.0
+#define BLOCK_HEADER_Y  30.0
+#define COLUMN_WIDTH    A4_WIDTH / 2.0
+#define MAX_COLUMN_Y    A4_HEIGHT - ymin_border
+#define BASE_Y          BLOCK_HEADER_Y + 10.0
+#define OFFSET_BASE     10.0
+#define OFFSET_SPACE    5.0
+#define COORD_X(factor) xmin_border + OFFSET_BASE + factor * (COLUMN_WIDTH - xmin_border - OFFSET_BASE)
+#define WRAP_LIMIT(val) (COLUMN_WIDTH - val) * PANGO_SCALE
+#define RES_FACTOR      96.0 / 72.0
+
+/* UTF-8 chars to distinguish different UCD data */
+static const unsigned char rightwards_arrow[] = { 0xE2, 0x86, 0x92, 0x0 };
+static const unsigned char bullet[] = { 0xE2, 0x80, 0xA2, 0x0 };
+static const unsigned char equal_sign[] = { 0x3D, 0x0 };
+static const unsigned char asterisk[] = { 0x2A, 0x0 };
+static const unsigned char reference_mark[] = { 0xE2, 0x80, 0xBB, 0x0 };
+static const unsigned char approx[] = { 0xE2, 0x89, 0x88, 0x0 };
+static const unsigned char equiv[] = { 0xE2, 0x89, 0xA1, 0x0 };
+static const unsigned char tilde[] = { 0x7E, 0x0 };
+static const unsigned char less_than[] = { 0x3C, 0x0 };
+static const unsigned char greater_than[] = { 0x3E, 0x0 };
+
+struct ucd_style {
+  const char * const name;
+  const char * const style;
+};
+
+static struct ucd_style ucd_styles[] = { { "notice_line", "Sans Italic 6" }, {
+    "block_header", "Sans Bold 11" }, { "block_subheader", "Sans Bold 9" }, {
+    "other", "Serif 7" }, { NULL, NULL } };
+
+static const char const *get_ucd_style(const char *name) {
+  struct ucd_style *style = ucd_styles;
+
+  for (; style->name; style++) {
+    if (!strcmp(name, style->name))
+      return style->style;
+  }
+
+  return NULL;
+}
+
+/* Initialize all fonts needed for generating UCD comments */
+static void init_ucd_fonts(struct fntsample_context *ctx) {
+  if (ctx->block_header_font)
+    return;
+
+  ctx->block_header_font = pango_font_description_from_string(
+      get_ucd_style("block_header"));
+  ctx->subheader_font = pango_font_description_from_string(
+      get_ucd_style("block_subheader"));
+  ctx->notice_line_font = pango_font_description_from_string(
+      get_ucd_style("notice_line"));
+  ctx->other_font = pango_font_description_from_string(get_ucd_style("other"));
+}
+
+/* Size of the text drawn by draw_ucd_text() */
+struct ucd_text_size {
+  double width;
+  double height;
+};
+
+#define ASCII_FIRST 0x20
+#define ASCII_LAST  0x7E
+
+/*
+ * Glyphs of the printable ASCII characters in a UCD font. Most of the UCD
+ * text (character names, aliases and notes) is plain ASCII, which needs no
+ * shaping, so it is drawn with these glyphs directly instead of Pango.
+ */
+struct ascii_font {
+  const PangoFontDescription *desc;
+  cairo_scaled_font_t *font; /* NULL if the font lacks some of the glyphs */
+  unsigned long glyphs[ASCII_LAST - ASCII_FIRST + 1];
+  double advances[ASCII_LAST - ASCII_FIRST + 1];
+  double ascent;
+  double height; /* of a line, as laid out by Pango */
+};
+
+/*
+ * Get glyphs of the printable ASCII characters in the font 'desc', loading
+ * them on the first use. Fonts are resolved the same way Pango does it,
+ * so text drawn with either of them looks the same. Returns NULL if memory
+ * runs out.
+ */
+static const struct ascii_font *get_ascii_font(struct fntsample_context *ctx,
+    const PangoFontDescription *desc) {
+  struct ascii_font *f;
+  PangoFont *font;
+  cairo_scaled_font_t *scaled;
+  cairo_glyph_t *glyphs = NULL;
+  cairo_font_extents_t font_extents;
+  cairo_text_extents_t extents;
+  char text[ASCII_LAST - ASCII_FIRST + 2];
+  int i, num_glyphs = 0;
+
+  for (i = 0; i < (int) ctx->n_ascii_fonts; i++) {
+    if (ctx->ascii_fonts[i].desc == desc)
+      return &ctx->ascii_fonts[i];
+  }
+
+  f = realloc(ctx->ascii_fonts, (ctx->n_ascii_fonts + 1) * sizeof(*f));
+  if (!f) {
+    out_of_memory(ctx);
+    return NULL;
+  }
+  ctx->ascii_fonts = f;
+  f = &ctx->ascii_fonts[ctx->n_ascii_fonts++];
+  f->desc = desc;
+  f->font = NULL;
+
+  font = pango_font_map_load_font(ctx->font_map, ctx->pango_context, desc);
+  if (!font)
+    return f;
+
+  scaled = pango_cairo_font_get_scaled_font(PANGO_CAIRO_FONT(font));
+  for (i = ASCII_FIRST; i <= ASCII_LAST; i++)
+    text[i - ASCII_FIRST] = i;
+  text[i - ASCII_FIRST] = '\0';
+
+  if (scaled
+      && cairo_scaled_font_text_to_glyphs(scaled, 0, 0, text, -1, &glyphs,
+          &num_glyphs, NULL, NULL, NULL) == CAIRO_STATUS_SUCCESS
+      && num_glyphs == G_N_ELEMENTS(f->glyphs)) {
+    /* Pango would take missing characters from another font */
+    for (i = 0; i < num_glyphs && glyphs[i].index; i++) {
+      cairo_scaled_font_glyph_extents(scaled, &glyphs[i], 1, &extents);
+      f->glyphs[i] = glyphs[i].index;
+      f->advances[i] = extents.x_advance;
+    }
+
+    if (i == num_glyphs) {
+      cairo_scaled_font_extents(scaled, &font_extents);
+      f->ascent = font_extents.ascent;
+      f->height = font_extents.ascent + font_extents.descent;
+      f->font = cairo_scaled_font_reference(scaled);
+    }
+  }
+
+  cairo_glyph_free(glyphs);
+  g_object_unref(font);
+  return f;
+}
+
+static void free_ascii_fonts(struct fntsample_context *ctx) {
+  unsigned int i;
+
+  for (i = 0; i < ctx->n_ascii_fonts; i++) {
+    if (ctx->ascii_fonts[i].font)
+      cairo_scaled_font_destroy(ctx->ascii_fonts[i].font);
+  }
+
+  free(ctx->ascii_fonts);
+  ctx->ascii_fonts = NULL;
+  ctx->n_ascii_fonts = 0;
+}
+
+/*
+ * Add a run of UCD annotations, if they are being recorded. Returns the
+ * zeroed run, or NULL.
+ */
+static struct ucd_run *record_ucd_run(struct fntsample_context *ctx,
+    enum ucd_run_kind kind) {
+  struct ucd_run *run;
+
+  if (!ctx->ucd_recording || ctx->failed)
+    return NULL;
+
+  if (ctx->ucd_runs_len == ctx->ucd_runs_size) {
+    size_t size = ctx->ucd_runs_size ? ctx->ucd_runs_size * 2 : 256;
+
+    run = realloc(ctx->ucd_runs, size * sizeof(*run));
+    if (!run) {
+      out_of_memory(ctx);
+      return NULL;
+    }
+    ctx->ucd_runs = run;
+    ctx->ucd_runs_size = size;
+  }
+
+  run = &ctx->ucd_runs[ctx->ucd_runs_len++];
+  memset(run, '\0', sizeof(*run));
+  run->kind = kind;
+  return run;
+}
+
+/*
+ * Record the layout to be shown at the current point.
+ */
+static void record_ucd_layout(struct fntsample_context *ctx, cairo_t *cr,
+    PangoLayout *layout) {
+  struct ucd_run *run = record_ucd_run(ctx, UCD_RUN_LAYOUT);
+
+  if (run) {
+    cairo_get_current_point(cr, &run->x, &run->y);
+    run->layout = g_object_ref(layout);
+  }
+}
+
+static void free_ucd_runs(struct fntsample_context *ctx) {
+  size_t i;
+
+  for (i = 0; i < ctx->ucd_runs_len; i++) {
+    if (ctx->ucd_runs[i].layout)
+      g_object_unref(ctx->ucd_runs[i].layout);
+    free(ctx->ucd_runs[i].glyphs);
+  }
+
+  free(ctx->ucd_runs);
+  ctx->ucd_runs = NULL;
+  ctx->ucd_runs_len = ctx->ucd_runs_size = ctx->ucd_runs_pos = 0;
+  ctx->ucd_recording = false;
+}
+
+/*
+ * Draw printable ASCII text at the current point with the glyphs of
+ * get_ascii_font(), wrapping lines at spaces (or anywhere, if a word does
+ * not fit) like PANGO_WRAP_WORD. 'width' is the wrap width, negative for no
+ * wrapping. Kerning is not applied. Returns false if the text contains
+ * other characters, or the font cannot be used; nothing is drawn then.
+ */
+static bool draw_ascii_text(struct fntsample_context *ctx, cairo_t *cr,
+    const char *text, const PangoFontDescription *desc, double width,
+    struct ucd_text_size *size) {
+  const struct ascii_font *f;
+  struct ucd_run *run;
+  cairo_glyph_t buf[256], *glyphs = buf;
+  size_t len, i, start, brk, n = 0;
+  double x0, y0, x, y, line_width, brk_width;
+  int lines = 0;
+
+  for (len = 0; text[len]; len++) {
+    if (text[len] < ASCII_FIRST || text[len] > ASCII_LAST)
+      return false;
+  }
+
+  f = get_ascii_font(ctx, desc);
+  if (!f || !f->font)
+    return false;
+
+  if (len > G_N_ELEMENTS(buf)) {
+    glyphs = malloc(len * sizeof(*glyphs));
+    if (!glyphs) {
+      out_of_memory(ctx);
+      return false;
+    }
+  }
+
+  cairo_get_current_point(cr, &x0, &y0);
+  size->width = 0.0;
+
+  start = 0;
+  do {
+    /* Find the end of the line: after the last space that fits */
+    x = 0.0;
+    line_width = 0.0;
+    brk = len;
+    brk_width = 0.0;
+    for (i = start; i < len; i++) {
+      double advance = f->advances[text[i] - ASCII_FIRST];
+
+      if (text[i] == ' ') {
+        /* Spaces at the end of a wrapped line do not count */
+        brk = i + 1;
+        brk_width = line_width;
+      }
+      else if (width >= 0 && i > start && x + advance > width) {
+        if (brk == len) {
+          brk = i;
+          brk_width = line_width;
+        }
+        break;
+      }
+      else line_width = x + advance;
+      x += advance;
+    }
+    if (i == len) {
+      brk = len;
+      brk_width = x;
+    }
+
+    x = x0;
+    y = y0 + lines * f->height + f->ascent;
+    for (i = start; i < brk; i++) {
+      glyphs[n++] = (cairo_glyph_t) {f->glyphs[text[i] - ASCII_FIRST], x, y};
+      x += f->advances[text[i] - ASCII_FIRST];
+    }
+
+    size->width = MAX(size->width, brk_width);
+    lines++;
+    start = brk;
+  } while (start < len);
+
+  if (!ctx->page_skipped) {
+    cairo_save(cr);
+    cairo_set_scaled_font(cr, f->font);
+    cairo_show_glyphs(cr, glyphs, n);
+    cairo_restore(cr);
+  }
+
+  run = record_ucd_run(ctx, UCD_RUN_GLYPHS);
+  if (run) {
+    run->font = f->font;
+    run->glyphs = malloc(n * sizeof(*glyphs));
+    if (!run->glyphs)
+      out_of_memory(ctx);
+    else {
+      memcpy(run->glyphs, glyphs, n * sizeof(*glyphs));
+      run->n_glyphs = n;
+    }
+  }
+
+  size->height = lines * f->height;
+  if (glyphs != buf)
+    free(glyphs);
+  return true;
+}
+
+/*
+ * Draw basic text with the given font at the current point and wrap it
+ * (optional). Returns the size of the text. Text of skipped pages (see
+ * fntsample_set_pages()) is only laid out.
+ */
+static struct ucd_text_size draw_ucd_text(struct fntsample_context *ctx,
+    cairo_t *cr, const char *text, PangoFontDescription *font, int wrap_width) {
+  struct ucd_text_size size;
+  PangoLayout *layout;
+  int width, height;
+
+  if (draw_ascii_text(ctx, cr, text, font,
+      wrap_width != -1.0 ? COLUMN_WIDTH - wrap_width : -1.0, &size))
+    return size;
+
+  layout = layout_text(ctx, font, text, NULL);
+  pango_layout_set_width(layout,
+      wrap_width != -1.0 ? WRAP_LIMIT(wrap_width) : -1.0);
+  pango_layout_set_wrap(layout, PANGO_WRAP_WORD);
+  if (!ctx->page_skipped)
+    pango_cairo_show_layout(cr, layout);
+  record_ucd_layout(ctx, cr, layout);
+  pango_layout_get_size(layout, &width, &height);
+  g_object_unref(layout);
+
+  size.width = (double) width / PANGO_SCALE;
+  size.height = (double) height / PANGO_SCALE;
+  return size;
+}
+
+/*
+ * Draw header of the UCD block.
+ */
+static double draw_ucd_block_header(struct fntsample_context *ctx,
+    cairo_t *cr, const char *block_header_name) {
+  PangoLayout *layout;
+  PangoRectangle r;
+  int height;
+
+  layout = layout_text(ctx, ctx->block_header_font, block_header_name, &r);
+  cairo_move_to(cr, BLOCK_HEADER_X((double) r.width), BLOCK_HEADER_Y);
+  if (!ctx->page_skipped)
+    pango_cairo_show_layout(cr, layout);
+  record_ucd_layout(ctx, cr, layout);
+  pango_layout_get_size(layout, NULL, &height);
+  g_object_unref(layout);
+  return (double) height / PANGO_SCALE;
+}
+
+/* Draw single UCD char code using given font and coordinates */
+static struct ucd_text_size draw_ucd_charcode(struct fntsample_context *ctx,
+    cairo_t *cr, PangoFontDescription *font, FT_ULong charcode, double x,
+    double y) {
+  char code[8];
+
+  /* Draw the char code (fill with '0' if less than 4 signs) */
+  cairo_move_to(cr, x, y);
+  sprintf(code, "%04lX", charcode);
+  return draw_ucd_text(ctx, cr, code, font, -1.0);
+}
+
+/* Draw the first and the last character code drawn at the current page */
+static void draw_ucd_char_limits(struct fntsample_context *ctx, cairo_t *cr,
+    FT_ULong leftLimit, FT_ULong rightLimit) {
+  double width;
+
+  /* Limits of skipped pages are only laid out to be replayed */
+  if (ctx->page_skipped && !ctx->ucd_recording)
+    return;
+
+  /* Draw left char code and get its width */
+  width = draw_ucd_charcode(ctx, cr, ctx->block_header_font, leftLimit,
+      xmin_border, BLOCK_HEADER_Y).width;
+
+  /* Draw right char code */
+  draw_ucd_charcode(ctx, cr, ctx->block_header_font, rightLimit,
+      A4_WIDTH - xmin_border - width, BLOCK_HEADER_Y);
+}
+
+/*
+ * Draw properties of character entries, subheaders or blocks
+ */
+static struct ucd_text_size draw_ucd_tag(struct fntsample_context *ctx,
+    cairo_t *cr, const struct ucd_tag * const tag, double x, double y,
+    double offset) {
+  const char *content = ucd_string(ctx->ucd, tag->content);
+  struct ucd_text_size size = { 0.0, 0.0 };
+
+  /* Move to the proper place */
+  cairo_move_to(cr, x, y);
+
+  /* NOTICE LINE */
+  if (tag->kind == UCD_NOTICE_LINE) {
+    char *text = NULL;
+    uint32_t i;
+
+    /* If the notice line has any additional attributes - check them */
+    for (i = 0; i < tag->n_attrs; i++) {
+      const struct ucd_attr *attr = &ctx->ucd->attrs[tag->first_attr + i];
+
+      if (strcmp(ucd_string(ctx->ucd, attr->name), xmlAttrs.WITH_ASTERISK) == 0) {
+        free(text);
+        text = malloc(snprintf(NULL, 0, "%s %s", asterisk, content) + 1);
+        sprintf(text, "%s %s", asterisk, content);
+      }
+    }
+
+    /* Draw text, free memory if needed */
+    if (text) {
+      size = draw_ucd_text(ctx, cr, text, ctx->notice_line_font,
+          xmin_border + OFFSET_BASE);
+      free(text);
+    }
+    else {
+      size = draw_ucd_text(ctx, cr, content, ctx->notice_line_font,
+          xmin_border + OFFSET_BASE);
+    }
+
+    return size;
+  }
+
+  /* At first draw a sign, then draw the content (take care of the sign width) */
+
+  /* COMMENT LINE */
+  if (tag->kind == UCD_COMMENT_LINE) {
+    char *text = malloc(snprintf(NULL, 0, "%s ", bullet) + 1);
+    sprintf(text, "%s ", bullet);
+    size = draw_ucd_text(ctx, cr, text, ctx->other_font, -1.0);
+    free(text);
+  }
+
+  /* ALIAS LINE */
+  if (tag->kind == UCD_ALIAS_LINE) {
+    char *text = malloc(snprintf(NULL, 0, "%s ", equal_sign) + 1);
+    sprintf(text, "%s ", equal_sign);
+    size = draw_ucd_text(ctx, cr, text, ctx->other_font, -1.0);
+    free(text);
+  }
+
+  /* CROSS REF */
+  if (tag->kind == UCD_CROSS_REF) {
+    char *text = malloc(snprintf(NULL, 0, "%s ", rightwards_arrow) + 1);
+    sprintf(text, "%s ", rightwards_arrow);
+    size = draw_ucd_text(ctx, cr, text, ctx->other_font, -1.0);
+    free(text);
+  }
+
+  /* COMPAT MAPPING */
+  if (tag->kind == UCD_COMPAT_MAPPING) {
+    char *text = malloc(snprintf(NULL, 0, "%s ", approx) + 1);
+    sprintf(text, "%s ", approx);
+    size = draw_ucd_text(ctx, cr, text, ctx->other_font, -1.0);
+    free(text);
+  }
+
+  /* VARIATION LINE */
+  if (tag->kind == UCD_VARIATION_LINE) {
+    char *text = malloc(snprintf(NULL, 0, "%s ", tilde) + 1);
+    sprintf(text, "%s ", tilde);
+    size = draw_ucd_text(ctx, cr, text, ctx->other_font, -1.0);
+    free(text);
+  }
+
+  /* DECOMPOSITION */
+  if (tag->kind == UCD_DECOMPOSITION) {
+    char *text = malloc(snprintf(NULL, 0, "%s ", equiv) + 1);
+    sprintf(text, "%s ", equiv);
+    size = draw_ucd_text(ctx, cr, text, ctx->other_font, -1.0);
+    free(text);
+  }
+
+  /* FORMAL ALIAS LINE */
+  if (tag->kind == UCD_FORMALALIAS_LINE) {
+    char *text = malloc(snprintf(NULL, 0, "%s ", reference_mark) + 1);
+    sprintf(text, "%s ", reference_mark);
+    size = draw_ucd_text(ctx, cr, text, ctx->other_font, -1.0);
+    free(text);
+  }
+
+  cairo_move_to(cr, x + size.width, y);
+  return draw_ucd_text(ctx, cr, content, ctx->other_font,
+      xmin_border + OFFSET_BASE + offset + size.width);
+}
+
+/*
+ * Finish a page of UCD comments with the given first and last character.
+ */
+static void show_ucd_page(struct fntsample_context *ctx, cairo_t *cr,
+    const struct ucd_block *block, FT_ULong first, FT_ULong last) {
+  struct ucd_run *run = record_ucd_run(ctx, UCD_RUN_PAGE);
+
+  if (run) {
+    run->block = block;
+    run->first = first;
+    run->last = last;
+  }
+  set_page_info(ctx, "ucd", ucd_string(ctx->ucd, block->name), first, last);
+  show_page(ctx, cr);
+}
+
+/*
+ * Check if the current 'y' coordinate is correct (in the text drawing area). If not
+ * change the column, where the text is drawn (optionally create new page). Draw the first
+ * and the last char together with page change. Draw current block header as the first
+ * element of the new page. Reset 'y' coordinate and update column  current indicator.
+ */
+static void check_and_update_coords(struct fntsample_context *ctx, cairo_t *cr,
+    double *factor, double *coordY, const struct ucd_block *block,
+    FT_ULong *firstChar, FT_ULong *lastChar) {
+  /* If the max coordinate for a column encountered show new page and update proper values */
+  if (*coordY >= MAX_COLUMN_Y) {
+    if (*factor == 1.0) {
+      FT_ULong first = *firstChar, last = *lastChar;
+
+      /* Draw code points of the first and the last character drawn at this page */
+      if (*firstChar != -1UL && *lastChar != -1UL) {
+        draw_ucd_char_limits(ctx, cr, *firstChar, *lastChar);
+        *firstChar = -1UL, *lastChar = -1UL;
+      }
+
+      /* Show the next page */
+      show_ucd_page(ctx, cr, block, first, last);
+    }
+
+    /* Update the factor and y coordinate */
+    *factor = abs(*factor - 1.0);
+    *coordY = BASE_Y;
+  }
+
+  /* If new page has been drawn show header and limits */
+  if (*coordY == BASE_Y) {
+    /* If new page added - draw the header's name and code points limits */
+    double height = draw_ucd_block_header(ctx, cr,
+        ucd_string(ctx->ucd, block->name));
+
+    /* Update the y coordinate */
+    *coordY += height;
+  }
+}
+
+/* Draw simple tags (notice lines, cross references, etc.). Update all variables during drawing.
+ *
+ * Parameters:
+ *   first_tag, n_tags - range of the tags in ctx->ucd->tags
+ *   multFactor - whether draw the text in the first column (0.0) or in the second one (1.0)
+ *   x - the offset of the x coordinate
+ *   y - the y coordinate
+ *   first - the first drawn character at this page
+ *   last - the last drawn character at this page
+ *   bl - the header block (the current one)
+ */
+static void draw_ucd_simple_tags(struct fntsample_context *ctx, cairo_t *cr,
+    uint32_t first_tag, uint32_t n_tags, double *multFactor, double x, double *y,
+    FT_ULong *first, FT_ULong *last, const struct ucd_block *bl) {
+  const struct ucd_tag *tag = &ctx->ucd->tags[first_tag];
+  const struct ucd_tag *end = tag + n_tags;
+
+  for (; tag < end; tag++) {
+    check_and_update_coords(ctx, cr, multFactor, y, bl, first, last);
+    *y += draw_ucd_tag(ctx, cr, tag, COORD_X(*multFactor) + x, *y, x).height;
+  }
+}
+
+/*
+ * Draw the character of a UCD entry with the font, scaled to the given
+ * height.
+ */
+static void draw_ucd_sample(struct fntsample_context *ctx, cairo_t *cr,
+    cairo_scaled_font_t *font, const cairo_glyph_t *glyph, double height) {
+  cairo_matrix_t matrix;
+  cairo_font_extents_t extents;
+
+  cairo_save(cr);
+  cairo_set_scaled_font(cr, font);
+  cairo_get_font_matrix(cr, &matrix);
+  cairo_font_extents(cr, &extents);
+  cairo_matrix_scale(&matrix, height / extents.height,
+      height / extents.height);
+  cairo_set_font_matrix(cr, &matrix);
+  show_glyphs(ctx, cr, glyph, 1);
+  cairo_restore(cr);
+}
+
+/* Draw a char entry (code point, char, name)
+ *
+ * Parameters:
+ *   multFactor - whether draw the text in the first column (0.0) or in the second one (1.0)
+ *   y - the y coordinate
+ *   first - the first drawn character at this page
+ *   last - the last drawn character at this page
+ *   block - the header block (the current one)
+ */
+static void draw_ucd_char_entry(struct fntsample_context *ctx, cairo_t *cr,
+    FT_Face ft_face, cairo_scaled_font_t *font, const struct ucd_char *entry,
+    double *multFactor, double *width, double *coordY, FT_ULong *first,
+    FT_ULong *last, const struct ucd_block *block) {
+  const char *name = ucd_string(ctx->ucd, entry->name);
+  struct ucd_text_size size;
+  double temp_width, text_height;
+  FT_UInt idx = FT_Get_Char_Index(ft_face, (FT_ULong) entry->cp);
+
+  // Draw charcode
+  check_and_update_coords(ctx, cr, multFactor, coordY, block, first, last);
+  size = draw_ucd_charcode(ctx, cr, ctx->other_font, entry->cp,
+      COORD_X(*multFactor), *coordY);
+
+  // Get the height of the comments' text and the width of the code
+  text_height = size.height * RES_FACTOR;
+  temp_width = size.width;
+
+  if (name) {
+    struct ucd_run *run;
+    cairo_glyph_t glyph =
+        (cairo_glyph_t) {idx, COORD_X(*multFactor) + OFFSET_SPACE + temp_width, *coordY + text_height / 2.0};
+
+    /* Try to draw sign */
+    draw_ucd_sample(ctx, cr, font, &glyph, text_height);
+    run = record_ucd_run(ctx, UCD_RUN_SAMPLE);
+    if (run) {
+      run->index = glyph.index;
+      run->x = glyph.x;
+      run->y = glyph.y;
+      run->height = text_height;
+    }
+    *width = 2.0 * OFFSET_SPACE + temp_width;
+
+    // Show the name of the char
+    cairo_move_to(cr, COORD_X(*multFactor) + OFFSET_SPACE + *width, *coordY);
+    size = draw_ucd_text(ctx, cr, name, ctx->other_font,
+        xmin_border + OFFSET_BASE);
+    *width = 2.0 * OFFSET_SPACE + *width;
+  }
+  else {
+    *width = temp_width;
+    cairo_move_to(cr, COORD_X(*multFactor) + OFFSET_SPACE + *width, *coordY);
+    const char *type = ucd_string(ctx->ucd, entry->type);
+    char *text = malloc(
+        snprintf(NULL, 0, "%s%s%s", less_than, type, greater_than) + 1);
+    sprintf(text, "%s%s%s", less_than, type, greater_than);
+    size = draw_ucd_text(ctx, cr, text, ctx->other_font,
+        xmin_border + OFFSET_BASE + OFFSET_SPACE);
+    *width = OFFSET_SPACE + *width;
+    free(text);
+  }
+  *coordY += size.height;
+}
+
+static int glyphs_can_be_drawn(struct fntsample_context *ctx, FT_Face ft_face,
+    const struct ucd_subheader *sub) {
+  const struct ucd_char *entry = &ctx->ucd->chars[sub->first_char];
+  const struct ucd_char *end = entry + sub->n_chars;
+
+  for (; entry < end; entry++) {
+    if (entry->name == UCD_NO_STRING || FT_Get_Char_Index(ft_face, entry->cp)) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+/*
+ * Draw UCD comments of the block as they were laid out for the first
+ * instance, with the characters of the current one. Returns false if the
+ * block was not recorded.
+ */
+static bool replay_ucd_data(struct fntsample_context *ctx, cairo_t *cr,
+    cairo_scaled_font_t *font, const struct ucd_block *block) {
+  const struct ucd_run *run = ctx->ucd_runs + ctx->ucd_runs_pos;
+  const struct ucd_run *end = ctx->ucd_runs + ctx->ucd_runs_len;
+
+  if (ctx->ucd_recording || run == end || run->kind != UCD_RUN_BLOCK
+      || run->block != block)
+    return false;
+
+  for (run++; run < end && run->kind != UCD_RUN_BLOCK; run++) {
+    cairo_glyph_t glyph;
+
+    switch (run->kind) {
+      case UCD_RUN_LAYOUT:
+        if (!ctx->page_skipped) {
+          cairo_move_to(cr, run->x, run->y);
+          pango_cairo_show_layout(cr, run->layout);
+        }
+        break;
+      case UCD_RUN_GLYPHS:
+        if (!ctx->page_skipped) {
+          cairo_save(cr);
+          cairo_set_scaled_font(cr, run->font);
+          cairo_show_glyphs(cr, run->glyphs, run->n_glyphs);
+          cairo_restore(cr);
+        }
+        break;
+      case UCD_RUN_SAMPLE:
+        glyph = (cairo_glyph_t) {run->index, run->x, run->y};
+        draw_ucd_sample(ctx, cr, font, &glyph, run->height);
+        break;
+      case UCD_RUN_PAGE:
+        show_ucd_page(ctx, cr, run->block, run->first, run->last);
+        break;
+      default:
+        break;
+    }
+  }
+
+  ctx->ucd_runs_pos = run - ctx->ucd_runs;
+  return true;
+}
+
+/*
+ * The main function of drawing UCD comments. It takes the character code and depending
+ * on the value chooses the actual block header.
+ */
+static void draw_ucd_data(struct fntsample_context *ctx, cairo_t *cr,
+    FT_Face ft_face, cairo_scaled_font_t *font, const FT_ULong charcode) {
+  double height = 0.0, width = 0.0;
+  double multFactor = 0.0; /* Draw text in the first column (0.0) or the second one (1.0) */
+  double coordY = BASE_Y; /* Coordinate Y */
+
+  /* The first and the last drawn character code */
+  FT_ULong drawnFirst = -1UL;
+  FT_ULong drawnLast = -1UL;
+
+  /* Get the block containing the given character */
+  const struct ucd_block *block = find_ucd_block(ctx->ucd, charcode);
+  const struct ucd_subheader *sub_block, *sub_end;
+  const struct ucd_char *entry, *entry_end;
+  struct ucd_run *run;
+
+  if (block) {
+    int64_t start = trace_begin();
+
+    /* Pages of the comments are traced separately from the charts */
+    ctx->page_start = start;
+
+    if (replay_ucd_data(ctx, cr, font, block)) {
+      trace_end("draw_ucd_data", ucd_string(ctx->ucd, block->name), start);
+      return;
+    }
+    run = record_ucd_run(ctx, UCD_RUN_BLOCK);
+    if (run)
+      run->block = block;
+
+    /* Draw all tags connected with this block header (notice lines, cross references, etc.) */
+    draw_ucd_simple_tags(ctx, cr, block->first_tag, block->n_tags, &multFactor, 0.0,
+        &coordY, &drawnFirst, &drawnLast, block);
+
+    sub_block = &ctx->ucd->subheaders[block->first_subheader];
+    sub_end = sub_block + block->n_subheaders;
+    for (; sub_block < sub_end; sub_block++) {
+      /* Do not draw comment if not in range */
+      if ((!in_range(ctx, sub_block->start) && !in_range(ctx, sub_block->end)) || glyphs_can_be_drawn(ctx, ft_face, sub_block) == 1)
+        continue;
+
+      /* Draw subheader name and update the 'y' coordinate */
+      check_and_update_coords(ctx, cr, &multFactor, &coordY, block, &drawnFirst,
+          &drawnLast);
+      cairo_move_to(cr, COORD_X(multFactor), coordY);
+      height = draw_ucd_text(ctx, cr, ucd_string(ctx->ucd, sub_block->name),
+          ctx->subheader_font, xmin_border + OFFSET_BASE).height;
+      coordY += height + 1.0;
+
+      /* Draw all tags connected with this subheader (notice lines, cross references, etc.) */
+      draw_ucd_simple_tags(ctx, cr, sub_block->first_tag, sub_block->n_tags, &multFactor,
+          0.0, &coordY, &drawnFirst, &drawnLast, block);
+
+      /* Draw all char entries from this block */
+      entry = &ctx->ucd->chars[sub_block->first_char];
+      entry_end = entry + sub_block->n_chars;
+      for (; entry < entry_end; entry++) {
+        /* Do not draw comment if not in range */
+        if (!in_range(ctx, entry->cp) || (!FT_Get_Char_Index(ft_face, (FT_ULong) entry->cp) && entry->name != UCD_NO_STRING))
+          continue;
+
+        draw_ucd_char_entry(ctx, cr, ft_face, font, entry, &multFactor, &width,
+            &coordY, &drawnFirst, &drawnLast, block);
+
+        /* Update values of the first char (only at the beginning) and the last one (always) */
+        if (drawnFirst == -1UL) {
+          drawnFirst = entry->cp;
+        }
+        drawnLast = entry->cp;
+
+        /* Draw all information connected with this char entry */
+        draw_ucd_simple_tags(ctx, cr, entry->first_tag, entry->n_tags, &multFactor, width,
+            &coordY, &drawnFirst, &drawnLast, block);
+      }
+    }
+    /* Drawing ended before creating a new page */
+    draw_ucd_char_limits(ctx, cr, drawnFirst, drawnLast);
+
+    /* Drawing ended - show new page */
+    show_ucd_page(ctx, cr, block, drawnFirst, drawnLast);
+    trace_end("draw_ucd_data", ucd_string(ctx->ucd, block->name), start);
+  }
+}
+
+/* =================================================================================== */
+/* Coverage overview: a page per Unicode plane with a cell per code point. */
+
+/* A plane is a square of 256x256 cells, every row is 256 code points */
+#define OVERVIEW_CELL	1.5
+#define OVERVIEW_X	(xmin_border + 24.0)
+#define OVERVIEW_Y	ymin_border
+#define OVERVIEW_SIZE	(256 * OVERVIEW_CELL)
+
+/* Colors of the cells (0xRRGGBB), same as in the charts */
+#define OVERVIEW_UNDEFINED	0x000000
+#define OVERVIEW_CONTROL	0x000080
+#define OVERVIEW_DEFINED	0x808080
+#define OVERVIEW_COVERED	0xFFFFFF
+#define OVERVIEW_ADDED		0xFFFF99
+#define OVERVIEW_CHANGED	0xB3D9FF
+#define OVERVIEW_REMOVED	0xFF6666
+
+#define NUM_PLANES	17
+
+static const char *plane_name(unsigned int plane) {
+  switch (plane) {
+    case 0:
+      return _("Basic Multilingual Plane");
+    case 1:
+      return _("Supplementary Multilingual Plane");
+    case 2:
+      return _("Supplementary Ideographic Plane");
+    case 3:
+      return _("Tertiary Ideographic Plane");
+    case 14:
+      return _("Supplementary Special-purpose Plane");
+    case 15:
+      return _("Supplementary Private Use Area-A");
+    case 16:
+      return _("Supplementary Private Use Area-B");
+    default:
+      return _("Unassigned Plane");
+  }
+}
+
+/*
+ * Color of the code point 'charcode', which has glyph 'idx' in the font
+ * (0 if none).
+ */
+static uint32_t overview_color(struct fntsample_context *ctx,
+    unsigned long charcode, FT_UInt idx, FT_Face ft_other_face) {
+  FT_UInt other_idx = 0;
+
+  if (ft_other_face && in_range(ctx, charcode))
+    other_idx = FT_Get_Char_Index(ft_other_face, charcode);
+
+  if (idx) {
+    if (!ft_other_face)
+      return OVERVIEW_COVERED;
+    if (!other_idx)
+      return OVERVIEW_ADDED;
+    if (ctx->glyph_hashes && ctx->other_glyph_hashes) {
+      uint64_t hash = glyph_hash_get(ctx->glyph_hashes, idx);
+      uint64_t other_hash = glyph_hash_get(ctx->other_glyph_hashes, other_idx);
+
+      if (hash && other_hash && hash != other_hash)
+        return OVERVIEW_CHANGED;
+    }
+    return OVERVIEW_COVERED;
+  }
+
+  if (other_idx)
+    return OVERVIEW_REMOVED;
+  if (!g_unichar_isdefined(charcode))
+    return OVERVIEW_UNDEFINED;
+  return g_unichar_iscntrl(charcode) ? OVERVIEW_CONTROL : OVERVIEW_DEFINED;
+}
+
+/*
+ * Draw the cells of the plane as an image with a pixel per code point,
+ * scaled up without smoothing.
+ */
+static void draw_overview_map(struct fntsample_context *ctx, cairo_t *cr,
+    unsigned int plane, FT_Face ft_other_face) {
+  cairo_surface_t *image;
+  cairo_pattern_t *pattern;
+  unsigned char *data;
+  unsigned long first = (unsigned long) plane << 16, charcode;
+  size_t pos, lo = 0, hi = ctx->plan_len;
+  int stride;
+
+  image = cairo_image_surface_create(CAIRO_FORMAT_RGB24, 256, 256);
+  cairo_surface_flush(image);
+  data = cairo_image_surface_get_data(image);
+  stride = cairo_image_surface_get_stride(image);
+  if (!data) {
+    cairo_surface_destroy(image);
+    return;
+  }
+
+  /* The first character of the plan in this plane */
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+
+    if (ctx->plan[mid].charcode < first)
+      lo = mid + 1;
+    else hi = mid;
+  }
+  pos = lo;
+
+  for (charcode = first; charcode < first + 0x10000; charcode++) {
+    unsigned int offset = charcode - first;
+    uint32_t *pixel = (uint32_t *) (data + (offset >> 8) * stride) + (offset & 0xFF);
+    FT_UInt idx = 0;
+
+    if (pos < ctx->plan_len && ctx->plan[pos].charcode == charcode)
+      idx = ctx->plan[pos++].idx;
+    *pixel = overview_color(ctx, charcode, idx, ft_other_face);
+  }
+  cairo_surface_mark_dirty(image);
+
+  cairo_save(cr);
+  cairo_translate(cr, OVERVIEW_X, OVERVIEW_Y);
+  cairo_scale(cr, OVERVIEW_CELL, OVERVIEW_CELL);
+  cairo_set_source_surface(cr, image, 0, 0);
+  pattern = cairo_get_source(cr);
+  cairo_pattern_set_filter(pattern, CAIRO_FILTER_NEAREST);
+  cairo_paint(cr);
+  cairo_restore(cr);
+  cairo_surface_destroy(image);
+}
+
+/*
+ * Draw the row and column numbers, block boundaries and names of the
+ * blocks. Names which would overlap the previous one are left out.
+ */
+static void draw_overview_labels(struct fntsample_context *ctx, cairo_t *cr,
+    unsigned int plane) {
+  const struct unicode_block *block;
+  unsigned long first = (unsigned long) plane << 16;
+  double label_y = 0.0;
+  PangoLayout *layout;
+  PangoRectangle r;
+  char buf[9];
+  int i;
+
+  cairo_save(cr);
+  for (i = 0; i < 256; i += 16) {
+    snprintf(buf, sizeof(buf), "%04lX", first + i * 256);
+    layout = layout_text(ctx, ctx->overview_font, buf, &r);
+    cairo_move_to(cr, OVERVIEW_X - 2.0 - (double) r.width / PANGO_SCALE,
+        OVERVIEW_Y + (i + 1) * OVERVIEW_CELL);
+    pango_cairo_show_layout_line(cr, pango_layout_get_line_readonly(layout, 0));
+    g_object_unref(layout);
+
+    snprintf(buf, sizeof(buf), "%02X", i);
+    layout = layout_text(ctx, ctx->overview_font, buf, &r);
+    cairo_move_to(cr, OVERVIEW_X + i * OVERVIEW_CELL, OVERVIEW_Y - 2.0);
+    pango_cairo_show_layout_line(cr, pango_layout_get_line_readonly(layout, 0));
+    g_object_unref(layout);
+  }
+
+  cairo_set_line_width(cr, 0.4);
+  for (block = unicode_blocks; block->name; block++) {
+    unsigned long offset = block->start - first;
+    double x, y;
+
+    if (block->start < first || block->start >= first + 0x10000)
+      continue;
+
+    /* Boundary before the first code point of the block */
+    x = OVERVIEW_X + (offset & 0xFF) * OVERVIEW_CELL;
+    y = OVERVIEW_Y + (offset >> 8) * OVERVIEW_CELL;
+    cairo_set_source_rgb(cr, 1.0, 0.5, 0.0);
+    cairo_move_to(cr, OVERVIEW_X, y + OVERVIEW_CELL);
+    cairo_line_to(cr, x, y + OVERVIEW_CELL);
+    cairo_line_to(cr, x, y);
+    cairo_line_to(cr, OVERVIEW_X + OVERVIEW_SIZE, y);
+    cairo_stroke(cr);
+
+    layout = layout_text(ctx, ctx->overview_font, block->name, &r);
+    if (y >= label_y) {
+      cairo_set_source_rgb(cr, 0.0, 0.0, 0.0);
+      cairo_move_to(cr, OVERVIEW_X + OVERVIEW_SIZE + 4.0,
+          y + (double) r.height / PANGO_SCALE);
+      pango_cairo_show_layout_line(cr, pango_layout_get_line_readonly(layout, 0));
+      label_y = y + (double) r.height / PANGO_SCALE;
+    }
+    g_object_unref(layout);
+  }
+  cairo_restore(cr);
+}
+
+/*
+ * Draw the legend of the cell colors below the map.
+ */
+static void draw_overview_legend(struct fntsample_context *ctx, cairo_t *cr,
+    bool diff, bool changed) {
+  static const struct {
+    uint32_t color;
+    const char *text;
+    int diff; /* shown only when comparing with other font (1) or hashes (2) */
+  } entries[] = {
+      { OVERVIEW_COVERED, N_("Character in the font"), 0 },
+      { OVERVIEW_ADDED, N_("Not in the other font"), 1 },
+      { OVERVIEW_CHANGED, N_("Changed glyph"), 2 },
+      { OVERVIEW_REMOVED, N_("Only in the other font"), 1 },
+      { OVERVIEW_DEFINED, N_("Missing character"), 0 },
+      { OVERVIEW_CONTROL, N_("Control character"), 0 },
+      { OVERVIEW_UNDEFINED, N_("Undefined code point"), 0 } };
+  double y = OVERVIEW_Y + OVERVIEW_SIZE + 20.0;
+  PangoLayout *layout;
+  PangoRectangle r;
+  unsigned int i;
+
+  cairo_save(cr);
+  cairo_set_line_width(cr, 0.5);
+  for (i = 0; i < G_N_ELEMENTS(entries); i++) {
+    uint32_t c = entries[i].color;
+
+    if ((entries[i].diff == 1 && !diff) || (entries[i].diff == 2 && !changed))
+      continue;
+
+    cairo_rectangle(cr, OVERVIEW_X, y, 8.0, 8.0);
+    cairo_set_source_rgb(cr, (c >> 16) / 255.0, ((c >> 8) & 0xFF) / 255.0,
+        (c & 0xFF) / 255.0);
+    cairo_fill_preserve(cr);
+    cairo_set_source_rgb(cr, 0.0, 0.0, 0.0);
+    cairo_stroke(cr);
+
+    layout = layout_text(ctx, ctx->table_numbers_font, _(entries[i].text), &r);
+    cairo_move_to(cr, OVERVIEW_X + 14.0, y + 8.0);
+    pango_cairo_show_layout_line(cr, pango_layout_get_line_readonly(layout, 0));
+    g_object_unref(layout);
+    y += 14.0;
+  }
+  cairo_restore(cr);
+}
+
+/*
+ * Draw an overview page for every plane with characters of the font
+ * (or of the other font).
+ */
+static void draw_overview(struct fntsample_context *ctx, cairo_t *cr,
+    FT_Face ft_face, const char *fontname, FT_Face ft_other_face) {
+  bool planes[NUM_PLANES] = { false };
+  unsigned int plane;
+  FT_ULong charcode;
+  FT_UInt idx;
+  size_t i;
+
+  if (!ctx->plan_valid)
+    build_plan(ctx, ft_face);
+
+  for (i = 0; i < ctx->plan_len; i++) {
+    if (ctx->plan[i].charcode >> 16 < NUM_PLANES)
+      planes[ctx->plan[i].charcode >> 16] = true;
+  }
+  if (ft_other_face) {
+    for (charcode = FT_Get_First_Char(ft_other_face, &idx); idx;
+        charcode = FT_Get_Next_Char(ft_other_face, charcode, &idx)) {
+      if (charcode >> 16 < NUM_PLANES && in_range(ctx, charcode))
+        planes[charcode >> 16] = true;
+    }
+  }
+
+  for (plane = 0; plane < NUM_PLANES; plane++) {
+    int64_t start = trace_begin();
+
+    if (drawing_done(ctx))
+      break;
+    if (!planes[plane])
+      continue;
+
+    outline(ctx, 1, ctx->pages_done + 1, plane_name(plane));
+    ctx->page_start = start;
+    if (!ctx->page_skipped) {
+      cairo_save(cr);
+      draw_header(ctx, cr, fontname, plane_name(plane));
+      draw_overview_map(ctx, cr, plane, ft_other_face);
+      draw_overview_labels(ctx, cr, plane);
+      draw_overview_legend(ctx, cr, ft_other_face != NULL,
+          ctx->glyph_hashes && ctx->other_glyph_hashes);
+      cairo_restore(cr);
+    }
+    set_page_info(ctx, "overview", plane_name(plane), (unsigned long) plane << 16,
+        ((unsigned long) plane << 16) + 0xFFFF);
+    show_page(ctx, cr);
+    trace_end("draw_overview", plane_name(plane), start);
+  }
+}
+
+/*
+ * The main drawing function.
+ */
+static void draw_glyphs(struct fntsample_context *ctx, cairo_t *cr,
+    cairo_scaled_font_t *font, FT_Face ft_face, const char *fontname,
+    FT_Face ft_other_face) {
+  FT_ULong charcode;
+  FT_UInt idx;
+  const struct unicode_block *block;
+
+  /*
+   * Pages are counted from the start of the document, which can have
+   * several fonts (instances) in it.
+   */
+  outline(ctx, 0, ctx->pages_done + 1, fontname);
+
+  if (ctx->overview != FNTSAMPLE_OVERVIEW_NONE)
+    draw_overview(ctx, cr, ft_face, fontname, ft_other_face);
+  if (ctx->overview == FNTSAMPLE_OVERVIEW_ONLY)
+    return;
+
+  charcode = get_first_char(ctx, ft_face, &idx);
+
+  /* Pages after the range are not even laid out */
+  while (idx && !drawing_done(ctx)) {
+    block = get_unicode_block(charcode);
+    if (block) {
+      outline(ctx, 1, ctx->pages_done + 1, block->name);
+      progress(ctx, FNTSAMPLE_PROGRESS_BLOCK_START, block->name);
+      if (ctx->compact_output
+          && is_sparse_block(ctx, ft_face, charcode, block))
+        draw_compact_block(ctx, cr, font, ft_face, fontname, &charcode,
+            block, ft_other_face);
+      else draw_unicode_block(ctx, cr, font, ft_face, fontname, &charcode,
+          block, ft_other_face);
+
+      /* Draw comments */
+      if (ctx->ucd && !drawing_done(ctx)) {
+        draw_ucd_data(ctx, cr, ft_face, font, charcode);
+      }
+      progress(ctx, FNTSAMPLE_PROGRESS_BLOCK_END, block->name);
+    }
+    charcode = get_next_char(ctx, ft_face, charcode, &idx);
+  }
+}
+
+/*
+ * Try to get font name for a given font face.
+ * Returned name should be free()'d after use.
+ * Returns NULL if memory cannot be allocated.
+ */
+static const char *get_font_name(FT_Face face) {
+  FT_Error error;
+  FT_SfntName face_name;
+  char *fontname;
+
+  /*
+   * try SFNT format; named instances of variable fonts share the full name
+   * of the default instance, they are named by family and style instead
+   */
+  error = face->face_index >> 16 ? FT_Err_Invalid_Argument
+      : FT_Get_Sfnt_Name(face, 4 /* full font name */, &face_name);
+  if (!error) {
+    fontname = malloc(face_name.string_len + 1);
+    if (!fontname)
+      return NULL;
+    memcpy(fontname, face_name.string, face_name.string_len);
+    fontname[face_name.string_len] = '\0';
+    return fontname;
+  }
+
+  /* try Type1 format */
+  PS_FontInfoRec fontinfo;
+
+  error = FT_Get_PS_Font_Info(face, &fontinfo);
+  if (!error) {
+    if (fontinfo.full_name)
+      return strdup(fontinfo.full_name);
+  }
+
+  /* fallback */
+  const char *family_name = face->family_name ? face->family_name : "Unknown";
+  const char *style_name = face->style_name ? face->style_name : "";
+  size_t len = strlen(family_name) + strlen(style_name) + 1/* for space */;
+
+  fontname = malloc(len + 1);
+  if (!fontname)
+    return NULL;
+
+  sprintf(fontname, "%s %s", family_name, style_name);
+  return fontname;
+}
+
+/*
+ * Calculate various offsets.
+ */
+static void calculate_offsets(struct fntsample_context *ctx) {
+  PangoRectangle extents;
+  /* Assume that vertical extents does not depend on actual text */
+  PangoLayout *l = layout_text(ctx, ctx->cell_numbers_font,
+      "0123456789ABCDEF", &extents);
+  g_object_unref(l);
+  /* Unsolved mistery of pango's font metrics.... */
+  double digits_ascent = pango_units_to_double(PANGO_DESCENT(extents));
+  double digits_descent = -pango_units_to_double(PANGO_ASCENT(extents));
+
+  ctx->cell_label_offset = digits_descent + 2;
+  ctx->cell_glyph_bot_offset = ctx->cell_label_offset + digits_ascent + 2;
+}
+
+/*
+ * Create cairo scaled font with the best size (hopefuly...)
+ * Returns NULL if the font cannot be fitted into cells.
+ */
+static cairo_scaled_font_t *create_default_font(struct fntsample_context *ctx,
+    cairo_font_face_t *cr_face) {
+  cairo_matrix_t font_matrix;
+  cairo_matrix_t ctm;
+  cairo_font_options_t *options = cairo_font_options_create();
+  cairo_scaled_font_t *cr_font;
+  cairo_font_extents_t extents;
+
+  /* First create font with size 1 and measure it */
+  cairo_matrix_init_identity(&font_matrix);
+  cairo_matrix_init_identity(&ctm);
+  /* Turn off rounding, so we can get real metrics */
+  cairo_font_options_set_hint_metrics(options, CAIRO_HINT_METRICS_OFF);
+  cr_font = cairo_scaled_font_create(cr_face, &font_matrix, &ctm, options);
+  cairo_scaled_font_extents(cr_font, &extents);
+
+  /* Use some magic to find the best font size... */
+  double tgt_size = ctx->cell_height - ctx->cell_glyph_bot_offset - 2;
+  double act_size = extents.ascent + extents.descent;
+  cairo_scaled_font_destroy(cr_font);
+  if (tgt_size <= 0 || act_size <= 0) {
+    if (tgt_size <= 0)
+      fprintf(stderr,
+          _("Not enough space for rendering glyphs. Make cell font smaller.\n"));
+    else fprintf(stderr,
+        _("The font has strange metrics: ascent + descent = %g\n"), act_size);
+    cairo_font_options_destroy(options);
+    return NULL;
+  }
+  double scale = tgt_size / act_size;
+  if (scale > 1)
+    scale = trunc(scale); // just to make numbers nicer
+  if (scale > 20)
+    scale = 20; // Do not make font larger than in previous versions
+
+  /* Create the font once again, but this time scaled */
+  cairo_matrix_init_scale(&font_matrix, scale, scale);
+  cr_font = cairo_scaled_font_create(cr_face, &font_matrix, &ctm, options);
+  cairo_scaled_font_extents(cr_font, &extents);
+  if (ctx->glyph_metrics)
+    ctx->glyph_metrics_scale = scale / ctx->glyph_metrics->units_per_em;
+  ctx->glyph_baseline_offset = (tgt_size - (extents.ascent + extents.descent))
+      / 2 + 2 + extents.ascent;
+
+  cairo_font_options_destroy(options);
+  return cr_font;
+}
+
+
+/*
+ * Create a font map for label fonts: either a font map that knows only
+ * about fonts given with fntsample_add_label_font_file(), or one that
+ * uses the system fontconfig configuration. The private fontconfig
+ * configuration does not read system configuration nor scan font
+ * directories, and font fallback is limited to the given files.
+ */
+static int init_font_map(struct fntsample_context *ctx) {
+  const struct label_font *f;
+  PangoFontMap *map;
+
+  if (ctx->font_map && ctx->loaded_label_fonts == ctx->last_label_font)
+    return FNTSAMPLE_OK;
+
+  if (ctx->label_fonts) {
+    FcConfig *config = FcConfigCreate();
+
+    if (!config) {
+      perror("FcConfigCreate");
+      return FNTSAMPLE_ERROR;
+    }
+
+    for (f = ctx->label_fonts; f; f = f->next) {
+      if (!FcConfigAppFontAddFile(config, (const FcChar8 *) f->file_name)) {
+        fprintf(stderr, _("Failed to load label font file %s\n"),
+            f->file_name);
+        FcConfigDestroy(config);
+        return FNTSAMPLE_ERROR_FONT;
+      }
+    }
+
+    map = pango_cairo_font_map_new_for_font_type(CAIRO_FONT_TYPE_FT);
+    if (map)
+      pango_fc_font_map_set_config(PANGO_FC_FONT_MAP(map), config);
+    FcConfigDestroy(config);
+  }
+  else map = pango_cairo_font_map_new();
+
+  if (!map) {
+    fprintf(stderr, _("Failed to create font map for label fonts\n"));
+    return FNTSAMPLE_ERROR;
+  }
+
+  pango_cairo_font_map_set_resolution(PANGO_CAIRO_FONT_MAP(map), 72.0);
+
+  if (ctx->pango_context)
+    g_object_unref(ctx->pango_context);
+  if (ctx->font_map)
+    g_object_unref(ctx->font_map);
+
+  ctx->font_map = map;
+  ctx->pango_context = pango_font_map_create_context(map);
+  ctx->loaded_label_fonts = ctx->last_label_font;
+  return FNTSAMPLE_OK;
+}
+
+static const char *get_style(struct fntsample_context *ctx, const char *name) {
+  unsigned int i;
+
+  for (i = 0; styles[i].name; i++) {
+    if (!strcmp(name, styles[i].name))
+      return ctx->style_vals[i] ? ctx->style_vals[i] : styles[i].default_val;
+  }
+
+  return NULL;
+}
+
+static void replace_font_description(PangoFontDescription **desc,
+    const char *style) {
+  if (*desc)
+    pango_font_description_free(*desc);
+  *desc = pango_font_description_from_string(style);
+}
+
+/* Make the font smaller by 'scale', labels of dense grids have to fit the cells */
+static void scale_font_description(PangoFontDescription *desc, double scale) {
+  int size = pango_font_description_get_size(desc);
+
+  if (scale >= 1.0 || size <= 0)
+    return;
+
+  if (pango_font_description_get_size_is_absolute(desc))
+    pango_font_description_set_absolute_size(desc, size * scale);
+  else pango_font_description_set_size(desc, size * scale);
+}
+
+/*
+ * Initialize fonts used to print table headers and character codes.
+ */
+int fntsample_init_fonts(struct fntsample_context *ctx) {
+  PangoFontDescription *fonts[6];
+  double scale = (double) DEFAULT_GRID_SIZE
+      / MAX(ctx->grid_columns, ctx->grid_rows);
+  unsigned int i;
+  int status = init_font_map(ctx);
+
+  if (status)
+    return status;
+
+  free_templates(ctx);
+  free_ascii_fonts(ctx);
+  replace_font_description(&ctx->header_font, get_style(ctx, "header-font"));
+  replace_font_description(&ctx->font_name_font,
+      get_style(ctx, "font-name-font"));
+  replace_font_description(&ctx->table_numbers_font,
+      get_style(ctx, "table-numbers-font"));
+  replace_font_description(&ctx->grid_numbers_font,
+      get_style(ctx, "table-numbers-font"));
+  scale_font_description(ctx->grid_numbers_font, scale);
+  replace_font_description(&ctx->cell_numbers_font,
+      get_style(ctx, "cell-numbers-font"));
+  scale_font_description(ctx->cell_numbers_font, scale);
+  replace_font_description(&ctx->overview_font,
+      get_style(ctx, "overview-font"));
+
+  /* Load the fonts now, so that fontconfig caches are read */
+  fonts[0] = ctx->header_font;
+  fonts[1] = ctx->font_name_font;
+  fonts[2] = ctx->table_numbers_font;
+  fonts[3] = ctx->grid_numbers_font;
+  fonts[4] = ctx->cell_numbers_font;
+  fonts[5] = ctx->overview_font;
+  for (i = 0; i < G_N_ELEMENTS(fonts); i++) {
+    PangoFont *font = pango_font_map_load_font(ctx->font_map,
+        ctx->pango_context, fonts[i]);
+
+    if (font)
+      g_object_unref(font);
+  }
+
+  return FNTSAMPLE_OK;
+}
+
+struct fntsample_context *fntsample_context_new(const char *name) {
+  struct fntsample_context *ctx = calloc(1, sizeof(*ctx));
+
+  if (!ctx)
+    return NULL;
+
+  if (FT_Init_FreeType(&ctx->library)) {
+    free(ctx);
+    return NULL;
+  }
+
+  ctx->name = name;
+  ctx->compact_threshold = 25;
+  fntsample_set_grid(ctx, DEFAULT_GRID_SIZE, DEFAULT_GRID_SIZE);
+  return ctx;
+}
+
+void fntsample_context_free(struct fntsample_context *ctx) {
+  struct range *r, *next_range;
+  struct label_font *f, *next_font;
+  PangoFontDescription *fonts[] = { ctx->header_font, ctx->font_name_font,
+      ctx->table_numbers_font, ctx->grid_numbers_font, ctx->cell_numbers_font,
+      ctx->overview_font, ctx->notice_line_font,
+      ctx->block_header_font, ctx->subheader_font, ctx->other_font };
+  unsigned int i;
+
+  for (r = ctx->ranges; r; r = next_range) {
+    next_range = r->next;
+    free(r);
+  }
+
+  for (f = ctx->label_fonts; f; f = next_font) {
+    next_font = f->next;
+    free(f->file_name);
+    free(f);
+  }
+
+  for (i = 0; i < N_STYLES; i++)
+    free(ctx->style_vals[i]);
+
+  for (i = 0; i < G_N_ELEMENTS(fonts); i++) {
+    if (fonts[i])
+      pango_font_description_free(fonts[i]);
+  }
+
+  if (ctx->pango_context)
+    g_object_unref(ctx->pango_context);
+  if (ctx->font_map)
+    g_object_unref(ctx->font_map);
+
+  free_templates(ctx);
+  free_ascii_fonts(ctx);
+  free_ucd_data(ctx->ucd);
+  free(ctx->cache_dir);
+  free(ctx->font_file_name);
+  free(ctx->other_font_file_name);
+  free(ctx->plan);
+  FT_Done_FreeType(ctx->library);
+  free(ctx);
+}
+
+static int replace_string(char **dst, const char *src) {
+  char *s = NULL;
+
+  if (src) {
+    s = strdup(src);
+    if (!s)
+      return FNTSAMPLE_ERROR;
+  }
+
+  free(*dst);
+  *dst = s;
+  return FNTSAMPLE_OK;
+}
+
+int fntsample_set_font(struct fntsample_context *ctx, const char *file_name,
+    int index) {
+  ctx->font_index = index;
+  ctx->font_instance = 0;
+  ctx->plan_valid = false;
+  return replace_string(&ctx->font_file_name, file_name);
+}
+
+void fntsample_set_instance(struct fntsample_context *ctx, int instance) {
+  ctx->font_instance = instance;
+}
+
+char *fntsample_get_instance_name(struct fntsample_context *ctx,
+    int instance) {
+  FT_Face face;
+  char *name = NULL;
+
+  if (!ctx->font_file_name || instance < 1 || instance > 0x7FFF)
+    return NULL;
+
+  /* FreeType selects the instance given in the upper bits of the index */
+  if (font_blob_new_face(ctx->library, ctx->font_file_name,
+      ctx->font_index | ((FT_Long) instance << 16), &face))
+    return NULL;
+
+  if (instance <= face->style_flags >> 16 && face->style_name)
+    name = strdup(face->style_name);
+  FT_Done_Face(face);
+  return name;
+}
+
+int fntsample_set_other_font(struct fntsample_context *ctx,
+    const char *file_name, int index) {
+  ctx->other_index = index;
+  return replace_string(&ctx->other_font_file_name, file_name);
+}
+
+int fntsample_add_range(struct fntsample_context *ctx, uint32_t first,
+    uint32_t last, bool include) {
+  struct range *r;
+
+  if (first > last)
+    return FNTSAMPLE_ERROR;
+
+  r = malloc(sizeof(*r));
+  if (!r)
+    return FNTSAMPLE_ERROR;
+
+  r->first = first;
+  r->last = last;
+  r->include = include;
+  r->next = NULL;
+  ctx->plan_valid = false;
+
+  if (ctx->ranges)
+    ctx->last_range->next = r;
+  else ctx->ranges = r;
+
+  ctx->last_range = r;
+
+  return FNTSAMPLE_OK;
+}
+
+int fntsample_set_style(struct fntsample_context *ctx, const char *name,
+    const char *val) {
+  unsigned int i;
+
+  for (i = 0; styles[i].name; i++) {
+    if (!strcmp(name, styles[i].name))
+      return replace_string(&ctx->style_vals[i], val);
+  }
+
+  return FNTSAMPLE_ERROR;
+}
+
+int fntsample_get_style_info(unsigned int n, const char **name,
+    const char **default_val) {
+  if (n >= N_STYLES)
+    return -1;
+
+  *name = styles[n].name;
+  *default_val = styles[n].default_val;
+  return 0;
+}
+
+void fntsample_set_compact(struct fntsample_context *ctx, bool compact,
+    int threshold) {
+  ctx->compact_output = compact;
+  ctx->compact_threshold = threshold;
+}
+
+int fntsample_add_label_font_file(struct fntsample_context *ctx,
+    const char *file_name) {
+  struct label_font *f = calloc(1, sizeof(*f));
+
+  if (!f || replace_string(&f->file_name, file_name)) {
+    free(f);
+    return FNTSAMPLE_ERROR;
+  }
+
+  if (ctx->label_fonts)
+    ctx->last_label_font->next = f;
+  else ctx->label_fonts = f;
+
+  ctx->last_label_font = f;
+
+  return FNTSAMPLE_OK;
+}
+
+/* Drop UCD data that could not be replaced, it belongs to another file */
+static void unload_ucd(struct fntsample_context *ctx) {
+  free_ucd_data(ctx->ucd);
+  ctx->ucd = NULL;
+}
+
+int fntsample_load_ucd_xml(struct fntsample_context *ctx,
+    const char *file_name) {
+  struct ucd_data *ucd;
+  struct stat st;
+  int64_t start;
+
+  /*
+   * Files are compared and not their names: the same name can be another
+   * file (relative names given to the render server), and the file can
+   * be changed in place.
+   */
+  if (stat(file_name, &st)) {
+    fprintf(stderr, "%s: %s: %s\n", ctx->name, file_name, strerror(errno));
+    unload_ucd(ctx);
+    return FNTSAMPLE_ERROR;
+  }
+  if (ctx->ucd && st.st_dev == ctx->ucd_stat.st_dev
+      && st.st_ino == ctx->ucd_stat.st_ino
+      && st.st_size == ctx->ucd_stat.st_size
+      && st.st_mtim.tv_sec == ctx->ucd_stat.st_mtim.tv_sec
+      && st.st_mtim.tv_nsec == ctx->ucd_stat.st_mtim.tv_nsec)
+    return FNTSAMPLE_OK;
+
+  LIBXML_TEST_VERSION
+
+  /* Large files are parsed in parallel, block headers are independent */
+  start = trace_begin();
+  if (parse_ucd_xml_file(file_name, &ucd)) {
+    fprintf(stderr, _("%s: could not parse file %s\n"), ctx->name, file_name);
+    unload_ucd(ctx);
+    return FNTSAMPLE_ERROR;
+  }
+  trace_end("load_ucd_xml", file_name, start);
+
+  free_ucd_data(ctx->ucd);
+  ctx->ucd = ucd;
+  ctx->ucd_stat = st;
+
+  /* Initialize necessary fonts */
+  init_ucd_fonts(ctx);
+  return FNTSAMPLE_OK;
+}
+
+void fntsample_set_highlight_changed(struct fntsample_context *ctx,
+    bool highlight) {
+  ctx->highlight_changed = highlight;
+}
+
+void fntsample_set_overview(struct fntsample_context *ctx,
+    enum fntsample_overview overview) {
+  ctx->overview = overview;
+}
+
+int fntsample_set_cache_dir(struct fntsample_context *ctx, const char *dir) {
+  return replace_string(&ctx->cache_dir, dir);
+}
+
+int fntsample_set_pages(struct fntsample_context *ctx, int first, int last) {
+  if (first < 0 || last < 0 || (first && last && last < first))
+    return FNTSAMPLE_ERROR;
+
+  ctx->first_page = first ? first : (last ? 1 : 0);
+  ctx->last_page = last;
+  return FNTSAMPLE_OK;
+}
+
+int fntsample_set_grid(struct fntsample_context *ctx, unsigned int columns,
+    unsigned int rows) {
+  if (columns < 1 || columns > MAX_GRID_SIZE || rows < 1
+      || rows > MAX_GRID_SIZE)
+    return FNTSAMPLE_ERROR;
+
+  ctx->grid_columns = columns;
+  ctx->grid_rows = rows;
+  ctx->cell_width = (A4_WIDTH - 2 * xmin_border) / columns;
+  ctx->cell_height = (A4_HEIGHT - 2 * ymin_border) / rows;
+  return FNTSAMPLE_OK;
+}
+
+void fntsample_set_outline_func(struct fntsample_context *ctx,
+    fntsample_outline_func func, void *data) {
+  ctx->outline = func;
+  ctx->outline_data = data;
+}
+
+void fntsample_set_progress_func(struct fntsample_context *ctx,
+    fntsample_progress_func func, void *data) {
+  ctx->progress = func;
+  ctx->progress_data = data;
+}
+
+int fntsample_trace_open(const char *file_name) {
+  return trace_open(file_name) ? FNTSAMPLE_ERROR : FNTSAMPLE_OK;
+}
+
+int fntsample_trace_close(void) {
+  return trace_close() ? FNTSAMPLE_ERROR : FNTSAMPLE_OK;
+}
+
+int64_t fntsample_trace_begin(void) {
+  return trace_begin();
+}
+
+void fntsample_trace_end(const char *name, int64_t start) {
+  trace_end("fntsample", name, start);
+}
+
+/* A face used by cairo, with the library that owns it */
+struct owned_face {
+  FT_Library library;
+  FT_Face face;
+};
+
+static const cairo_user_data_key_t owned_face_key;
+
+static void free_owned_face(void *data) {
+  struct owned_face *f = data;
+
+  FT_Done_Face(f->face);
+  FT_Done_FreeType(f->library);
+  free(f);
+}
+
+/*
+ * Open the font face for drawing and create cairo font face for it.
+ * cairo can keep using the face after the rendering (e.g. until the
+ * surface is finished), so the face gets its own FT_Library and is
+ * freed by cairo together with the font face.
+ */
+static cairo_font_face_t *open_font_face(struct fntsample_context *ctx,
+    FT_Face *face) {
+  struct owned_face *f = malloc(sizeof(*f));
+  cairo_font_face_t *cr_face;
+
+  if (!f)
+    return NULL;
+
+  if (FT_Init_FreeType(&f->library)) {
+    /* TRANSLATORS: 'freetype' is a name of a library, and should be left untranslated */
+    fprintf(stderr, _("%s: freetype error\n"), ctx->name);
+    free(f);
+    return NULL;
+  }
+
+  if (font_blob_new_face(f->library, ctx->font_file_name,
+      font_face_index(ctx), &f->face)) {
+    fprintf(stderr, _("%s: failed to open font file %s\n"), ctx->name,
+        ctx->font_file_name);
+    FT_Done_FreeType(f->library);
+    free(f);
+    return NULL;
+  }
+
+  cr_face = cairo_ft_font_face_create_for_ft_face(f->face, 0);
+  if (cairo_font_face_set_user_data(cr_face, &owned_face_key, f,
+      free_owned_face)) {
+    cairo_font_face_destroy(cr_face);
+    free_owned_face(f);
+    return NULL;
+  }
+
+  *face = f->face;
+  return cr_face;
+}
+
+/*
+ * Render the font to the surface, or, if 'svg_base_name' is given,
+ * to separate SVG pages using the surface only for recording. Label
+ * fonts should be initialized by the caller (see fntsample_init_fonts()).
+ */
+static int render(struct fntsample_context *ctx, cairo_surface_t *surface,
+    const char *svg_base_name) {
+  cairo_font_face_t *cr_face;
+  cairo_t *cr;
+  FT_Face face, other_face = NULL;
+  const char *fontname; /* full name of the font */
+  cairo_status_t cr_status;
+  cairo_scaled_font_t *cr_font = NULL;
+  int status;
+
+  if (!ctx->font_file_name)
+    return FNTSAMPLE_ERROR;
+  ctx->failed = false;
+
+  cr_face = open_font_face(ctx, &face);
+  if (!cr_face)
+    return FNTSAMPLE_ERROR_FONT;
+
+  if (ctx->other_font_file_name) {
+    if (font_blob_new_face(ctx->library, ctx->other_font_file_name,
+        ctx->other_index, &other_face)) {
+      fprintf(stderr, _("%s: failed to create new font face\n"), ctx->name);
+      cairo_font_face_destroy(cr_face);
+      return FNTSAMPLE_ERROR_FONT;
+    }
+  }
+
+  fontname = get_font_name(face);
+  if (fontname && svg_base_name)
+    ctx->svg_pages = svg_pages_new(svg_base_name, face);
+  if (!fontname || (svg_base_name && !ctx->svg_pages)) {
+    out_of_memory(ctx);
+    free((char *) fontname);
+    if (other_face)
+      FT_Done_Face(other_face);
+    cairo_font_face_destroy(cr_face);
+    return FNTSAMPLE_ERROR;
+  }
+
+  /*
+   * Measure all glyphs at once, instead of asking cairo one by one.
+   * The dry run does not position glyphs, it needs no metrics.
+   */
+  if (ctx->overview != FNTSAMPLE_OVERVIEW_ONLY && !ctx->dry_run_out) {
+    if (ctx->cache_dir)
+      ctx->font_cache = font_cache_load(ctx->cache_dir, ctx->font_file_name,
+          font_face_index(ctx), face);
+    if (ctx->font_cache)
+      ctx->glyph_metrics = ctx->font_cache->metrics;
+    else ctx->glyph_metrics = glyph_metrics_load(ctx->font_file_name,
+        font_face_index(ctx), face);
+  }
+
+  /* Changed glyphs do not affect the pages, the dry run skips hashing */
+  if (other_face && ctx->highlight_changed && !ctx->dry_run_out) {
+    ctx->glyph_hashes = glyph_hash_get_table(ctx->cache_dir,
+        ctx->font_file_name, font_face_index(ctx));
+    ctx->other_glyph_hashes = glyph_hash_get_table(ctx->cache_dir,
+        ctx->other_font_file_name, ctx->other_index);
+  }
+
+  cr = cairo_create(surface);
+  cr_status = cairo_status(cr);
+  if (cr_status != CAIRO_STATUS_SUCCESS) {
+    fprintf(stderr, _("%s: cairo_create failed: %s\n"), ctx->name,
+        cairo_status_to_string(cr_status));
+    status = FNTSAMPLE_ERROR;
+  }
+  else {
+    /* The transformation of cr never changes, update Pango once */
+    pango_cairo_update_context(cr, ctx->pango_context);
+    calculate_offsets(ctx);
+
+    /*
+     * The dry run lays out what decides the pages as usual, but clips all
+     * drawing away, so cairo does no work. Chart pages are only counted.
+     */
+    if (ctx->dry_run_out) {
+      cairo_rectangle(cr, 0, 0, 0, 0);
+      cairo_clip(cr);
+    }
+    ctx->page_skipped = false;
+    begin_page(ctx, cr);
+
+    cr_font = create_default_font(ctx, cr_face);
+    if (!cr_font)
+      status = FNTSAMPLE_ERROR_METRICS;
+  }
+
+  if (cr_font) {
+    cr_status = cairo_scaled_font_status(cr_font);
+    if (cr_status != CAIRO_STATUS_SUCCESS) {
+      fprintf(stderr, _("%s: failed to create scaled font: %s\n"), ctx->name,
+          cairo_status_to_string(cr_status));
+      status = FNTSAMPLE_ERROR;
+    }
+    else {
+      /* Every page is drawn into its own group */
+      if (ctx->svg_pages)
+        cairo_push_group(cr);
+      cairo_set_source_rgb(cr, 0.0, 0.0, 0.0);
+      ctx->page_start = trace_begin();
+      draw_glyphs(ctx, cr, cr_font, face, fontname, other_face);
+      if (ctx->svg_pages)
+        cairo_pattern_destroy(cairo_pop_group(cr));
+    }
+    cairo_scaled_font_destroy(cr_font);
+  }
+
+  cairo_destroy(cr);
+  flush_outline(ctx, 0);
+  if (ctx->svg_pages) {
+    int64_t start = trace_begin();
+
+    if (svg_pages_finish(ctx->svg_pages, ctx->library, ctx->font_file_name,
+        font_face_index(ctx)) && !status)
+      status = FNTSAMPLE_ERROR;
+    ctx->svg_pages = NULL;
+    trace_end("finish", "SVG pages", start);
+  }
+  cairo_font_face_destroy(cr_face);
+  if (ctx->font_cache)
+    font_cache_free(ctx->font_cache);
+  else glyph_metrics_free(ctx->glyph_metrics);
+  ctx->font_cache = NULL;
+  ctx->glyph_metrics = NULL;
+  ctx->glyph_hashes = NULL;
+  ctx->other_glyph_hashes = NULL;
+  free((char *) fontname);
+  if (other_face)
+    FT_Done_Face(other_face);
+  if (ctx->failed && !status)
+    status = FNTSAMPLE_ERROR;
+  return status;
+}
+
+int fntsample_render(struct fntsample_context *ctx, cairo_surface_t *surface) {
+  int status = fntsample_init_fonts(ctx);
+
+  if (status)
+    return status;
+  ctx->pages_done = 0;
+  return render(ctx, surface, NULL);
+}
+
+int fntsample_render_instances(struct fntsample_context *ctx,
+    cairo_surface_t *surface, const int *instances, int n) {
+  int saved = ctx->font_instance;
+  int status, i;
+
+  /*
+   * Only the glyphs differ: the character plan, label fonts with the
+   * templates and glyphs drawn with them, and UCD data of the context are
+   * prepared once. UCD annotations are laid out for the first instance.
+   */
+  status = fntsample_init_fonts(ctx);
+  if (status)
+    return status;
+  ctx->pages_done = 0;
+  ctx->ucd_recording = ctx->ucd && n > 1;
+  for (i = 0; i < n && !status && !drawing_done(ctx); i++) {
+    ctx->font_instance = instances[i];
+    ctx->ucd_runs_pos = 0;
+    status = render(ctx, surface, NULL);
+    ctx->ucd_recording = false;
+  }
+
+  free_ucd_runs(ctx);
+  ctx->font_instance = saved;
+  return status;
+}
+
+int fntsample_render_svg_pages(struct fntsample_context *ctx,
+    const char *base_name) {
+  cairo_rectangle_t page = { 0, 0, A4_WIDTH, A4_HEIGHT };
+  cairo_surface_t *surface;
+  int status;
+
+  status = fntsample_init_fonts(ctx);
+  if (status)
+    return status;
+
+  surface = cairo_recording_surface_create(CAIRO_CONTENT_COLOR_ALPHA, &page);
+  ctx->pages_done = 0;
+  status = render(ctx, surface, base_name);
+  cairo_surface_destroy(surface);
+  return status;
+}
+
+int fntsample_plan(struct fntsample_context *ctx,
+    enum fntsample_report_format format, FILE *out) {
+  cairo_rectangle_t page = { 0, 0, A4_WIDTH, A4_HEIGHT };
+  cairo_surface_t *surface;
+  size_t i;
+  int status;
+
+  if (format == FNTSAMPLE_REPORT_JSON)
+    fputs("{\n  \"pages\": [", out);
+  else fputs("page,type,block,first,last,outline\n", out);
+
+  ctx->dry_run_out = out;
+  ctx->dry_run_format = format;
+  surface = cairo_recording_surface_create(CAIRO_CONTENT_COLOR_ALPHA, &page);
+  ctx->pages_done = 0;
+  status = fntsample_init_fonts(ctx);
+  if (!status)
+    status = render(ctx, surface, NULL);
+  cairo_surface_destroy(surface);
+  ctx->dry_run_out = NULL;
+
+  for (i = 0; i < ctx->dry_run_outline_len; i++)
+    free(ctx->dry_run_outline[i].text);
+  free(ctx->dry_run_outline);
+  ctx->dry_run_outline = NULL;
+  ctx->dry_run_outline_len = ctx->dry_run_outline_size = 0;
+
+  if (format == FNTSAMPLE_REPORT_JSON)
+    fputs("\n  ]\n}\n", out);
+  return status;
+}
+
+/* Statistics of a single Unicode block collected for the report */
+struct block_report {
+  unsigned long covered;
+  unsigned long ucd_entries;
+  unsigned long ucd_covered;
+};
+
+/* Growing, sorted list of character codes */
+struct code_list {
+  unsigned long *codes;
+  size_t len;
+  size_t size;
+  size_t pos; /* next code to print */
+};
+
+static int code_list_add(struct code_list *list, unsigned long charcode) {
+  if (list->len == list->size) {
+    size_t size = list->size ? list->size * 2 : 64;
+    unsigned long *codes = realloc(list->codes, size * sizeof(*codes));
+
+    if (!codes)
+      return -1;
+    list->codes = codes;
+    list->size = size;
+  }
+  list->codes[list->len++] = charcode;
+  return 0;
+}
+
+/* Count codes of the list that belong to the block, without consuming them */
+static unsigned long code_list_count(const struct code_list *list,
+    const struct unicode_block *block) {
+  size_t i = list->pos;
+
+  while (i < list->len && list->codes[i] < block->start)
+    i++;
+  while (i < list->len && list->codes[i] <= block->end)
+    i++;
+  return i - list->pos;
+}
+
+/*
+ * Print codes of the list that belong to the block and consume them.
+ * JSON arrays or space separated for CSV.
+ */
+static void print_code_list(FILE *out, struct code_list *list,
+    const struct unicode_block *block, enum fntsample_report_format format) {
+  bool first = true;
+
+  while (list->pos < list->len && list->codes[list->pos] < block->start)
+    list->pos++;
+
+  if (format == FNTSAMPLE_REPORT_JSON)
+    fputc('[', out);
+  for (; list->pos < list->len && list->codes[list->pos] <= block->end;
+      list->pos++) {
+    if (!first)
+      fputs(format == FNTSAMPLE_REPORT_JSON ? ", " : " ", out);
+    if (format == FNTSAMPLE_REPORT_JSON)
+      fprintf(out, "\"U+%04lX\"", list->codes[list->pos]);
+    else fprintf(out, "U+%04lX", list->codes[list->pos]);
+    first = false;
+  }
+  if (format == FNTSAMPLE_REPORT_JSON)
+    fputc(']', out);
+}
+
+/* Count UCD entries in range and covered by the font */
+static void count_ucd_entries(struct fntsample_context *ctx, FT_Face face,
+    struct block_report *reports) {
+  const struct ucd_char *entry = ctx->ucd->chars;
+  const struct ucd_char *end = entry + ctx->ucd->n_chars;
+
+  for (; entry < end; entry++) {
+    const struct unicode_block *block = get_unicode_block(entry->cp);
+
+    if (!block || !in_range(ctx, entry->cp))
+      continue;
+
+    reports[block - unicode_blocks].ucd_entries++;
+    if (FT_Get_Char_Index(face, entry->cp))
+      reports[block - unicode_blocks].ucd_covered++;
+  }
+}
+
+static void print_report(FILE *out, enum fntsample_report_format format,
+    FT_Face face, FT_Face other_face, bool changes, bool ucd,
+    struct block_report *reports, struct code_list *added,
+    struct code_list *removed, struct code_list *changed,
+    unsigned long total) {
+  const struct unicode_block *block;
+  bool first = true;
+
+  if (format == FNTSAMPLE_REPORT_JSON) {
+    fputs("{\n  \"family\": ", out);
+    print_json_string(out, face->family_name ? face->family_name : "");
+    fputs(",\n  \"style\": ", out);
+    print_json_string(out, face->style_name ? face->style_name : "");
+    fprintf(out, ",\n  \"covered\": %lu", total);
+    if (other_face)
+      fprintf(out, ",\n  \"added\": %lu,\n  \"removed\": %lu", (unsigned long)
+          added->len, (unsigned long) removed->len);
+    if (changes)
+      fprintf(out, ",\n  \"changed\": %lu", (unsigned long) changed->len);
+    fputs(",\n  \"blocks\": [", out);
+  }
+  else {
+    fputs("start,end,name,size,covered", out);
+    if (other_face)
+      fputs(",added,removed", out);
+    if (changes)
+      fputs(",changed", out);
+    if (ucd)
+      fputs(",ucd_entries,ucd_covered", out);
+    if (other_face)
+      fputs(",added_codepoints,removed_codepoints", out);
+    if (changes)
+      fputs(",changed_codepoints", out);
+    fputc('\n', out);
+  }
+
+  for (block = unicode_blocks; block->name; block++) {
+    const struct block_report *r = &reports[block - unicode_blocks];
+    unsigned long nremoved = code_list_count(removed, block);
+
+    /* Only blocks present in one of the fonts */
+    if (!r->covered && !nremoved)
+      continue;
+
+    if (format == FNTSAMPLE_REPORT_JSON) {
+      fprintf(out, "%s\n    { \"start\": \"U+%04lX\", \"end\": \"U+%04lX\", "
+          "\"name\": ", first ? "" : ",", block->start, block->end);
+      print_json_string(out, block->name);
+      fprintf(out, ", \"size\": %lu, \"covered\": %lu",
+          block->end - block->start + 1, r->covered);
+      if (ucd)
+        fprintf(out, ", \"ucd_entries\": %lu, \"ucd_covered\": %lu",
+            r->ucd_entries, r->ucd_covered);
+      if (other_face) {
+        fputs(", \"added\": ", out);
+        print_code_list(out, added, block, format);
+        fputs(", \"removed\": ", out);
+        print_code_list(out, removed, block, format);
+      }
+      if (changes) {
+        fputs(", \"changed\": ", out);
+        print_code_list(out, changed, block, format);
+      }
+      fputs(" }", out);
+    }
+    else {
+      fprintf(out, "U+%04lX,U+%04lX,", block->start, block->end);
+      print_csv_string(out, block->name);
+      fprintf(out, ",%lu,%lu", block->end - block->start + 1, r->covered);
+      if (other_face)
+        fprintf(out, ",%lu,%lu", code_list_count(added, block), nremoved);
+      if (changes)
+        fprintf(out, ",%lu", code_list_count(changed, block));
+      if (ucd)
+        fprintf(out, ",%lu,%lu", r->ucd_entries, r->ucd_covered);
+      if (other_face) {
+        fputc(',', out);
+        print_code_list(out, added, block, format);
+        fputc(',', out);
+        print_code_list(out, removed, block, format);
+      }
+      if (changes) {
+        fputc(',', out);
+        print_code_list(out, changed, block, format);
+      }
+      fputc('\n', out);
+    }
+    first = false;
+  }
+
+  if (format == FNTSAMPLE_REPORT_JSON)
+    fputs("\n  ]\n}\n", out);
+}
+
+/*
+ * Walk the cmap of the font (and of the other font) and print the
+ * statistics. Only FreeType is used, nothing is rendered.
+ */
+int fntsample_report(struct fntsample_context *ctx,
+    enum fntsample_report_format format, FILE *out) {
+  FT_Face face, other_face = NULL;
+  FT_ULong charcode;
+  FT_UInt idx;
+  const struct unicode_block *block = NULL;
+  struct block_report *reports;
+  struct code_list added = { NULL, 0, 0, 0 }, removed = { NULL, 0, 0, 0 },
+      changed = { NULL, 0, 0, 0 };
+  const struct glyph_hash_table *hashes = NULL, *other_hashes = NULL;
+  unsigned long total = 0, nblocks = 0;
+  int status = FNTSAMPLE_OK;
+
+  if (!ctx->font_file_name)
+    return FNTSAMPLE_ERROR;
+  ctx->failed = false;
+
+  if (font_blob_new_face(ctx->library, ctx->font_file_name,
+      font_face_index(ctx), &face)) {
+    fprintf(stderr, _("%s: failed to open font file %s\n"), ctx->name,
+        ctx->font_file_name);
+    return FNTSAMPLE_ERROR_FONT;
+  }
+
+  if (ctx->other_font_file_name) {
+    if (font_blob_new_face(ctx->library, ctx->other_font_file_name,
+        ctx->other_index, &other_face)) {
+      fprintf(stderr, _("%s: failed to create new font face\n"), ctx->name);
+      FT_Done_Face(face);
+      return FNTSAMPLE_ERROR_FONT;
+    }
+
+    if (ctx->highlight_changed) {
+      hashes = glyph_hash_get_table(ctx->cache_dir, ctx->font_file_name,
+          font_face_index(ctx));
+      other_hashes = glyph_hash_get_table(ctx->cache_dir,
+          ctx->other_font_file_name, ctx->other_index);
+    }
+  }
+
+  while (unicode_blocks[nblocks].name)
+    nblocks++;
+  reports = calloc(nblocks, sizeof(*reports));
+  if (!reports) {
+    out_of_memory(ctx);
+    if (other_face)
+      FT_Done_Face(other_face);
+    FT_Done_Face(face);
+    return FNTSAMPLE_ERROR;
+  }
+
+  /* Characters come in increasing order, so look up blocks only when needed */
+  for (charcode = get_first_char(ctx, face, &idx); idx;
+      charcode = get_next_char(ctx, face, charcode, &idx)) {
+    FT_UInt other_idx;
+
+    total++;
+    if (!block || !is_in_block(charcode, block))
+      block = get_unicode_block(charcode);
+    if (block)
+      reports[block - unicode_blocks].covered++;
+
+    if (!other_face)
+      continue;
+
+    other_idx = FT_Get_Char_Index(other_face, charcode);
+    if (!other_idx)
+      status |= code_list_add(&added, charcode);
+    else if (hashes && other_hashes) {
+      uint64_t hash = glyph_hash_get(hashes, idx);
+      uint64_t other_hash = glyph_hash_get(other_hashes, other_idx);
+
+      if (hash && other_hash && hash != other_hash)
+        status |= code_list_add(&changed, charcode);
+    }
+  }
+
+  /* The plan has characters of the font only, walk the other font itself */
+  if (other_face) {
+    for (charcode = FT_Get_First_Char(other_face, &idx); idx;
+        charcode = FT_Get_Next_Char(other_face, charcode, &idx)) {
+      if (in_range(ctx, charcode) && !FT_Get_Char_Index(face, charcode))
+        status |= code_list_add(&removed, charcode);
+    }
+  }
+
+  if (status)
+    out_of_memory(ctx);
+
+  if (!ctx->failed) {
+    if (ctx->ucd)
+      count_ucd_entries(ctx, face, reports);
+
+    print_report(out, format, face, other_face, hashes && other_hashes,
+        ctx->ucd != NULL, reports, &added, &removed, &changed, total);
+  }
+
+  free(added.codes);
+  free(removed.codes);
+  free(changed.codes);
+  free(reports);
+  if (other_face)
+    FT_Done_Face(other_face);
+  FT_Done_Face(face);
+  return ctx->failed ? FNTSAMPLE_ERROR : FNTSAMPLE_OK;
+}
+
+/* =================================================================================== */
+/* Export of the chart contents as JSON or HTML, without drawing. */
+
+/* State of the export of a font */
+struct export_state {
+  struct fntsample_context *ctx;
+  enum fntsample_export_format format;
+  FILE *out;
+  FT_Face face;
+  FT_Face other_face;
+  const struct glyph_hash_table *hashes;
+  const struct glyph_hash_table *other_hashes;
+  bool first; /* nothing written to the current JSON array yet */
+  unsigned long row; /* first code of the current HTML table row, -1UL if none */
+  unsigned long next; /* next code of the row without a cell */
+};
+
+/* Names of enum ucd_tag_kind in the output */
+static const char *const export_note_types[] = { "notice", "comment", "cross_ref",
+    "alias", "formal_alias", "variation", "decomposition", "compat_mapping" };
+
+static void print_html_string(FILE *out, const char *s) {
+  for (; *s; s++) {
+    switch (*s) {
+      case '&':
+        fputs("&amp;", out);
+        break;
+      case '<':
+        fputs("&lt;", out);
+        break;
+      case '>':
+        fputs("&gt;", out);
+        break;
+      case '"':
+        fputs("&quot;", out);
+        break;
+      default:
+        fputc(*s, out);
+    }
+  }
+}
+
+/* Character reference to show the character, if it can appear in HTML */
+static void print_html_char(FILE *out, unsigned long charcode) {
+  if (!g_unichar_iscntrl(charcode) && (charcode < 0xD800 || charcode > 0xDFFF))
+    fprintf(out, "&#x%lX;", charcode);
+}
+
+/*
+ * Status of the character of the font compared to the other font, the
+ * same as highlighted in the charts. NULL if unchanged.
+ */
+static const char *export_status(const struct export_state *st,
+    unsigned long charcode, FT_UInt idx) {
+  FT_UInt other_idx;
+
+  if (!st->other_face)
+    return NULL;
+
+  other_idx = FT_Get_Char_Index(st->other_face, charcode);
+  if (!other_idx)
+    return "added";
+
+  if (st->hashes && st->other_hashes) {
+    uint64_t hash = glyph_hash_get(st->hashes, idx);
+    uint64_t other_hash = glyph_hash_get(st->other_hashes, other_idx);
+
+    if (hash && other_hash && hash != other_hash)
+      return "changed";
+  }
+  return NULL;
+}
+
+/* HTML cells of codes from st->next up to 'end' not in the font */
+static void export_empty_cells(struct export_state *st, unsigned long end) {
+  for (; st->next < end; st->next++) {
+    const char *class = "undefined";
+
+    if (g_unichar_isdefined(st->next))
+      class = g_unichar_iscntrl(st->next) ? "control" : "missing";
+    fprintf(st->out, "<td class=\"%s\" title=\"U+%04lX\"></td>", class, st->next);
+  }
+}
+
+static void export_end_row(struct export_state *st) {
+  if (st->row == -1UL)
+    return;
+  export_empty_cells(st, st->row + 16);
+  fputs("</tr>\n", st->out);
+  st->row = -1UL;
+}
+
+static void export_block_start(struct export_state *st,
+    const struct unicode_block *block) {
+  FILE *out = st->out;
+  int i;
+
+  if (st->format == FNTSAMPLE_EXPORT_JSON) {
+    fprintf(out, "%s\n    {\"name\": ", st->first ? "" : ",");
+    print_json_string(out, block->name);
+    fprintf(out, ", \"start\": \"U+%04lX\", \"end\": \"U+%04lX\", \"characters\": [",
+        block->start, block->end);
+    st->first = false;
+  }
+  else {
+    fprintf(out, "<section id=\"U+%04lX\">\n<h2>", block->start);
+    print_html_string(out, block->name);
+    fputs("</h2>\n<table class=\"chart\">\n<tr><th></th>", out);
+    for (i = 0; i < 16; i++)
+      fprintf(out, "<th>%X</th>", i);
+    fputs("</tr>\n", out);
+  }
+}
+
+/* A character of the font in the block table */
+static void export_char(struct export_state *st, bool first_in_block,
+    unsigned long charcode, FT_UInt idx) {
+  const char *status = export_status(st, charcode, idx);
+  FILE *out = st->out;
+
+  if (st->format == FNTSAMPLE_EXPORT_JSON) {
+    fprintf(out, "%s{\"code\": \"U+%04lX\", \"glyph\": %u", first_in_block ? "" : ", ",
+        charcode, idx);
+    if (status)
+      fprintf(out, ", \"status\": \"%s\"", status);
+    fputc('}', out);
+    return;
+  }
+
+  if ((charcode & ~0xFUL) != st->row) {
+    export_end_row(st);
+    st->row = st->next = charcode & ~0xFUL;
+    fprintf(out, "<tr><th>%03lX</th>", st->row / 16);
+  }
+  export_empty_cells(st, charcode);
+  fprintf(out, "<td class=\"g%s%s\" title=\"U+%04lX\">", status ? " " : "",
+      status ? status : "", charcode);
+  print_html_char(out, charcode);
+  fputs("</td>", out);
+  st->next = charcode + 1;
+}
+
+/* Notices, aliases, cross references etc. of a UCD element */
+static void export_ucd_notes(struct export_state *st, uint32_t first_tag,
+    uint32_t n_tags) {
+  const struct ucd_data *ucd = st->ctx->ucd;
+  FILE *out = st->out;
+  uint32_t i, j;
+
+  if (st->format == FNTSAMPLE_EXPORT_JSON)
+    fputs(", \"notes\": [", out);
+
+  for (i = 0; i < n_tags; i++) {
+    const struct ucd_tag *tag = &ucd->tags[first_tag + i];
+    const char *content = ucd_string(ucd, tag->content);
+    bool asterisk = false;
+
+    for (j = 0; j < tag->n_attrs; j++) {
+      if (!strcmp(ucd_string(ucd, ucd->attrs[tag->first_attr + j].name),
+          xmlAttrs.WITH_ASTERISK))
+        asterisk = true;
+    }
+
+    if (st->format == FNTSAMPLE_EXPORT_JSON) {
+      fprintf(out, "%s{\"type\": \"%s\", \"text\": ", i ? ", " : "",
+          export_note_types[tag->kind]);
+      print_json_string(out, content ? content : "");
+      if (asterisk)
+        fputs(", \"asterisk\": true", out);
+      fputc('}', out);
+    }
+    else {
+      fprintf(out, "<p class=\"%s\">", export_note_types[tag->kind]);
+      if (asterisk)
+        fputs("* ", out);
+      print_html_string(out, content ? content : "");
+      fputs("</p>\n", out);
+    }
+  }
+
+  if (st->format == FNTSAMPLE_EXPORT_JSON)
+    fputc(']', out);
+}
+
+/* A UCD character entry, with its name or type */
+static void export_ucd_char(struct export_state *st, bool first,
+    const struct ucd_char *entry) {
+  const struct ucd_data *ucd = st->ctx->ucd;
+  const char *name = ucd_string(ucd, entry->name);
+  const char *type = ucd_string(ucd, entry->type);
+  FILE *out = st->out;
+
+  if (st->format == FNTSAMPLE_EXPORT_JSON) {
+    fprintf(out, "%s{\"code\": \"U+%04X\", ", first ? "" : ", ", entry->cp);
+    fputs(name ? "\"name\": " : "\"type\": ", out);
+    print_json_string(out, name ? name : type ? type : "");
+    export_ucd_notes(st, entry->first_tag, entry->n_tags);
+    fputc('}', out);
+    return;
+  }
+
+  fprintf(out, "<dt id=\"ucd-%04X\"><code>%04X</code> ", entry->cp, entry->cp);
+  if (name) {
+    fputs("<span class=\"g\">", out);
+    print_html_char(out, entry->cp);
+    fputs("</span> ", out);
+    print_html_string(out, name);
+  }
+  else {
+    fputs("&lt;", out);
+    print_html_string(out, type ? type : "");
+    fputs("&gt;", out);
+  }
+  fputs("</dt>\n<dd>\n", out);
+  export_ucd_notes(st, entry->first_tag, entry->n_tags);
+  fputs("</dd>\n", out);
+}
+
+/*
+ * UCD data of the block with 'charcode', filtered the same way as in
+ * draw_ucd_data().
+ */
+static void export_ucd(struct export_state *st, unsigned long charcode) {
+  struct fntsample_context *ctx = st->ctx;
+  const struct ucd_block *block = find_ucd_block(ctx->ucd, charcode);
+  const struct ucd_subheader *sub, *sub_end;
+  const struct ucd_char *entry, *entry_end;
+  FILE *out = st->out;
+  bool first_sub = true;
+
+  if (!block)
+    return;
+
+  if (st->format == FNTSAMPLE_EXPORT_JSON)
+    fputs(", \"ucd\": {\"subheaders\": [", out);
+  else fputs("<div class=\"ucd\">\n", out);
+
+  sub = &ctx->ucd->subheaders[block->first_subheader];
+  sub_end = sub + block->n_subheaders;
+  for (; sub < sub_end; sub++) {
+    const char *name = ucd_string(ctx->ucd, sub->name);
+    bool first = true;
+
+    if ((!in_range(ctx, sub->start) && !in_range(ctx, sub->end))
+        || glyphs_can_be_drawn(ctx, st->face, sub) == 1)
+      continue;
+
+    if (st->format == FNTSAMPLE_EXPORT_JSON) {
+      fprintf(out, "%s{\"name\": ", first_sub ? "" : ", ");
+      print_json_string(out, name ? name : "");
+      export_ucd_notes(st, sub->first_tag, sub->n_tags);
+      fputs(", \"characters\": [", out);
+    }
+    else {
+      fputs("<h3>", out);
+      print_html_string(out, name ? name : "");
+      fputs("</h3>\n", out);
+      export_ucd_notes(st, sub->first_tag, sub->n_tags);
+      fputs("<dl>\n", out);
+    }
+    first_sub = false;
+
+    entry = &ctx->ucd->chars[sub->first_char];
+    entry_end = entry + sub->n_chars;
+    for (; entry < entry_end; entry++) {
+      if (!in_range(ctx, entry->cp)
+          || (!FT_Get_Char_Index(st->face, entry->cp) && entry->name != UCD_NO_STRING))
+        continue;
+      export_ucd_char(st, first, entry);
+      first = false;
+    }
+
+    fputs(st->format == FNTSAMPLE_EXPORT_JSON ? "]}" : "</dl>\n", out);
+  }
+
+  if (st->format == FNTSAMPLE_EXPORT_JSON) {
+    fputc(']', out);
+    export_ucd_notes(st, block->first_tag, block->n_tags);
+    fputc('}', out);
+  }
+  else {
+    export_ucd_notes(st, block->first_tag, block->n_tags);
+    fputs("</div>\n", out);
+  }
+}
+
+static void export_block_end(struct export_state *st, unsigned long last) {
+  if (st->format == FNTSAMPLE_EXPORT_HTML) {
+    export_end_row(st);
+    fputs("</table>\n", st->out);
+  }
+  else fputc(']', st->out);
+
+  if (st->ctx->ucd)
+    export_ucd(st, last);
+
+  fputs(st->format == FNTSAMPLE_EXPORT_JSON ? "}" : "</section>\n", st->out);
+}
+
+static void export_header(struct export_state *st, const char *fontname) {
+  FILE *out = st->out;
+  char *path, *uri;
+
+  if (st->format == FNTSAMPLE_EXPORT_JSON) {
+    fputs("{\n  \"font\": ", out);
+    print_json_string(out, fontname);
+    fputs(",\n  \"file\": ", out);
+    print_json_string(out, st->ctx->font_file_name);
+    fputs(",\n  \"blocks\": [", out);
+    return;
+  }
+
+  fputs("<!DOCTYPE html>\n<html>\n<head>\n<meta charset=\"utf-8\">\n<title>", out);
+  print_html_string(out, fontname);
+  fputs("</title>\n<style>\n@font-face { font-family: \"fntsample\"; src: url(\"", out);
+  /* The page can be opened from anywhere, the font is referred to by a file: URL */
+  path = realpath(st->ctx->font_file_name, NULL);
+  uri = path ? g_filename_to_uri(path, NULL, NULL) : NULL;
+  print_html_string(out, uri ? uri : st->ctx->font_file_name);
+  g_free(uri);
+  free(path);
+  fputs("\"); }\n"
+      ".g { font-family: \"fntsample\"; }\n"
+      "table.chart { border-collapse: collapse; }\n"
+      "table.chart td { border: 1px solid black; width: 2em; height: 2em; text-align: center; }\n"
+      "td.missing { background: #808080; }\n"
+      "td.control { background: #000080; }\n"
+      "td.undefined { background: black; }\n"
+      "td.added { background: #ffff99; }\n"
+      "td.changed { background: #b3d9ff; }\n"
+      "</style>\n</head>\n<body>\n<h1>", out);
+  print_html_string(out, fontname);
+  fputs("</h1>\n", out);
+}
+
+int fntsample_export(struct fntsample_context *ctx,
+    enum fntsample_export_format format, FILE *out) {
+  struct export_state st;
+  FT_ULong charcode;
+  FT_UInt idx;
+  const struct unicode_block *block = NULL;
+  const char *fontname;
+  unsigned long last = 0;
+  bool first_in_block = true;
+
+  if (!ctx->font_file_name)
+    return FNTSAMPLE_ERROR;
+  ctx->failed = false;
+
+  memset(&st, 0, sizeof(st));
+  st.ctx = ctx;
+  st.format = format;
+  st.out = out;
+  st.first = true;
+  st.row = -1UL;
+
+  if (font_blob_new_face(ctx->library, ctx->font_file_name,
+      font_face_index(ctx), &st.face)) {
+    fprintf(stderr, _("%s: failed to open font file %s\n"), ctx->name,
+        ctx->font_file_name);
+    return FNTSAMPLE_ERROR_FONT;
+  }
+
+  if (ctx->other_font_file_name) {
+    if (font_blob_new_face(ctx->library, ctx->other_font_file_name,
+        ctx->other_index, &st.other_face)) {
+      fprintf(stderr, _("%s: failed to create new font face\n"), ctx->name);
+      FT_Done_Face(st.face);
+      return FNTSAMPLE_ERROR_FONT;
+    }
+
+    if (ctx->highlight_changed) {
+      st.hashes = glyph_hash_get_table(ctx->cache_dir, ctx->font_file_name,
+          font_face_index(ctx));
+      st.other_hashes = glyph_hash_get_table(ctx->cache_dir,
+          ctx->other_font_file_name, ctx->other_index);
+    }
+  }
+
+  fontname = get_font_name(st.face);
+  if (!fontname) {
+    out_of_memory(ctx);
+    if (st.other_face)
+      FT_Done_Face(st.other_face);
+    FT_Done_Face(st.face);
+    return FNTSAMPLE_ERROR;
+  }
+  export_header(&st, fontname);
+
+  /* The same blocks in the same order as in the charts */
+  for (charcode = get_first_char(ctx, st.face, &idx); idx;
+      charcode = get_next_char(ctx, st.face, charcode, &idx)) {
+    if (!block || !is_in_block(charcode, block)) {
+      if (block)
+        export_block_end(&st, last);
+      block = get_unicode_block(charcode);
+      if (!block)
+        continue;
+      export_block_start(&st, block);
+      first_in_block = true;
+    }
+    export_char(&st, first_in_block, charcode, idx);
+    first_in_block = false;
+    last = charcode;
+  }
+  if (block)
+    export_block_end(&st, last);
+
+  fputs(format == FNTSAMPLE_EXPORT_JSON ? "\n  ]\n}\n" : "</body>\n</html>\n", out);
+
+  free((char *) fontname);
+  if (st.other_face)
+    FT_Done_Face(st.other_face);
+  FT_Done_Face(st.face);
+  return ctx->failed ? FNTSAMPLE_ERROR : FNTSAMPLE_OK;
+}
@@ -0,0 +1,263 @@
+/* Copyright © 2007-2010 Євгеній Мещеряков <eugen@debian.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * libfntsample - font samples renderer.
+ *
+ * All state of the renderer is kept in a context. Different contexts
+ * share nothing mutable, so they can be used concurrently from different
+ * threads; a single context must not be used by two threads at a time.
+ */
+
+#ifndef LIBFNTSAMPLE_H_
+#define LIBFNTSAMPLE_H_
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <cairo.h>
+
+/* Size of a page (A4 paper), surfaces given to fntsample_render() should have it */
+#define FNTSAMPLE_PAGE_WIDTH	(8.3*72)
+#define FNTSAMPLE_PAGE_HEIGHT	(11.7*72)
+
+/* Return values of the library functions, they double as program exit codes */
+enum fntsample_status {
+  FNTSAMPLE_OK = 0,
+  FNTSAMPLE_ERROR = 1,
+  FNTSAMPLE_ERROR_FREETYPE = 3,
+  FNTSAMPLE_ERROR_FONT = 4,
+  FNTSAMPLE_ERROR_METRICS = 5
+};
+
+/* Coverage overview pages, see fntsample_set_overview() */
+enum fntsample_overview {
+  FNTSAMPLE_OVERVIEW_NONE,
+  FNTSAMPLE_OVERVIEW_FIRST, /* overview pages before the charts */
+  FNTSAMPLE_OVERVIEW_ONLY
+};
+
+/* Formats of fntsample_report() */
+enum fntsample_report_format {
+  FNTSAMPLE_REPORT_JSON,
+  FNTSAMPLE_REPORT_CSV
+};
+
+/* Formats of fntsample_export() */
+enum fntsample_export_format {
+  FNTSAMPLE_EXPORT_JSON,
+  FNTSAMPLE_EXPORT_HTML
+};
+
+/* Events passed to fntsample_progress_func */
+enum fntsample_progress_event {
+  FNTSAMPLE_PROGRESS_BLOCK_START,
+  FNTSAMPLE_PROGRESS_BLOCK_END,
+  FNTSAMPLE_PROGRESS_PAGE
+};
+
+struct fntsample_context;
+
+/*
+ * Called for every outline (bookmark) entry of the document:
+ * 'level' 0 is the font, 1 is a Unicode block.
+ */
+typedef void (*fntsample_outline_func)(void *data, int level, int page,
+    const char *text);
+
+/*
+ * Called when drawing of a Unicode block starts and ends ('block' is its
+ * name), and after every page (with NULL 'block'). 'pages' is the number
+ * of pages finished so far.
+ */
+typedef void (*fntsample_progress_func)(void *data,
+    enum fntsample_progress_event event, int pages, const char *block);
+
+/*
+ * Create new context. 'name' is used as a prefix of error messages.
+ * Returns NULL on error.
+ */
+struct fntsample_context *fntsample_context_new(const char *name);
+
+void fntsample_context_free(struct fntsample_context *ctx);
+
+/* Select the font to render, and optionally the font to compare with */
+int fntsample_set_font(struct fntsample_context *ctx, const char *file_name,
+    int index);
+int fntsample_set_other_font(struct fntsample_context *ctx,
+    const char *file_name, int index);
+
+/*
+ * Select the named instance of a variable font set with
+ * fntsample_set_font(), counted from 1. 0 (the default) selects the
+ * default coordinates of the font.
+ */
+void fntsample_set_instance(struct fntsample_context *ctx, int instance);
+
+/*
+ * Get the name of the named instance 'instance' of the font, or NULL if
+ * there is no such instance. The name should be free()'d after use.
+ */
+char *fntsample_get_instance_name(struct fntsample_context *ctx,
+    int instance);
+
+/* Show (include == true) or hide characters in the range [first, last] */
+int fntsample_add_range(struct fntsample_context *ctx, uint32_t first,
+    uint32_t last, bool include);
+
+/* Set style (see fntsample_get_style_info()) to the Pango font description 'val' */
+int fntsample_set_style(struct fntsample_context *ctx, const char *name,
+    const char *val);
+
+/*
+ * Get name and default value of the n-th style.
+ * Returns -1 if there is no such style.
+ */
+int fntsample_get_style_info(unsigned int n, const char **name,
+    const char **default_val);
+
+/* Draw blocks covered less than 'threshold' percent as compact tables */
+void fntsample_set_compact(struct fntsample_context *ctx, bool compact,
+    int threshold);
+
+/*
+ * Also highlight glyphs whose outlines or advances differ from the glyphs
+ * of the other font (see fntsample_set_other_font()).
+ */
+void fntsample_set_highlight_changed(struct fntsample_context *ctx,
+    bool highlight);
+
+/*
+ * Draw a coverage overview page for every Unicode plane with characters
+ * of the font: a cell per code point, colored by coverage, difference
+ * from the other font and the character class, with Unicode blocks marked.
+ */
+void fntsample_set_overview(struct fntsample_context *ctx,
+    enum fntsample_overview overview);
+
+/*
+ * Keep characters and glyph metrics of the fonts in the directory 'dir',
+ * keyed by the contents of the font file, so that charting the same font
+ * again does not measure its glyphs. NULL (the default) disables the cache.
+ */
+int fntsample_set_cache_dir(struct fntsample_context *ctx, const char *dir);
+
+/*
+ * Draw charts with 'columns' x 'rows' cells per page instead of 16x16
+ * (both at most 64). Glyphs and labels of denser grids are made smaller.
+ * Returns FNTSAMPLE_ERROR if the size is out of range.
+ */
+int fntsample_set_grid(struct fntsample_context *ctx, unsigned int columns,
+    unsigned int rows);
+
+/*
+ * Draw only pages 'first' to 'last' (counted from 1) of the document.
+ * Pages before them are still laid out, so the drawn pages are the same
+ * as in the whole document; outline entries point to pages of the output.
+ * 0 for 'last' means up to the end, 0 for both draws all pages (the
+ * default). Ignored by fntsample_plan().
+ */
+int fntsample_set_pages(struct fntsample_context *ctx, int first, int last);
+
+/* Use only fonts from the given files for labels (can be called repeatedly) */
+int fntsample_add_label_font_file(struct fntsample_context *ctx,
+    const char *file_name);
+
+/*
+ * Load UCD data used to annotate the blocks. Loading the same file
+ * again does nothing. If the file cannot be loaded, UCD data loaded
+ * before is dropped.
+ */
+int fntsample_load_ucd_xml(struct fntsample_context *ctx,
+    const char *file_name);
+
+void fntsample_set_outline_func(struct fntsample_context *ctx,
+    fntsample_outline_func func, void *data);
+
+void fntsample_set_progress_func(struct fntsample_context *ctx,
+    fntsample_progress_func func, void *data);
+
+/*
+ * Write spans of the work done by the library (in all contexts and their
+ * worker threads) to 'file_name' in the Chrome trace event format, until
+ * fntsample_trace_close() is called.
+ */
+int fntsample_trace_open(const char *file_name);
+int fntsample_trace_close(void);
+
+/*
+ * Add a span of the caller's own work to the trace: 'start' is returned
+ * by fntsample_trace_begin() (0 if tracing is off) when the span starts.
+ */
+int64_t fntsample_trace_begin(void);
+void fntsample_trace_end(const char *name, int64_t start);
+
+/*
+ * Load label fonts now, instead of during the first rendering.
+ * Useful for long running processes that fork workers.
+ */
+int fntsample_init_fonts(struct fntsample_context *ctx);
+
+/* Render samples of the font to the surface */
+int fntsample_render(struct fntsample_context *ctx, cairo_surface_t *surface);
+
+/*
+ * Render the named instances 'instances' of a variable font one after
+ * another to the surface, every one of them as a separate section of the
+ * document. The character plan, label fonts and UCD data are prepared
+ * only once.
+ */
+int fntsample_render_instances(struct fntsample_context *ctx,
+    cairo_surface_t *surface, const int *instances, int n);
+
+/*
+ * Render every page into its own SVG file 'base_name'-NNNN.svg. Glyphs of
+ * the font are defined once in 'base_name'-glyphs.svg and referenced from
+ * the pages. Pages are written in parallel.
+ */
+int fntsample_render_svg_pages(struct fntsample_context *ctx,
+    const char *base_name);
+
+/*
+ * Print the pages fntsample_render() would draw to 'out', without drawing
+ * anything: for every page its type (overview, chart, compact or ucd), the
+ * Unicode block, the span of character codes shown and the outline entries
+ * pointing to it. Text is still laid out, so that pages of UCD comments
+ * break at the same places.
+ */
+int fntsample_plan(struct fntsample_context *ctx,
+    enum fntsample_report_format format, FILE *out);
+
+/*
+ * Print per-block coverage of the font to 'out' without rendering anything:
+ * numbers of covered characters, characters added and removed relative to
+ * the other font, changed glyphs (if highlighted) and coverage of the
+ * loaded UCD entries.
+ */
+int fntsample_report(struct fntsample_context *ctx,
+    enum fntsample_report_format format, FILE *out);
+
+/*
+ * Write the contents of the charts to 'out' as JSON or a static HTML
+ * page, without drawing: for every block the characters of the font
+ * (referenced by code point, with glyph index and status relative to the
+ * other font) and the UCD names, aliases, cross references and notices
+ * that would be shown with them.
+ */
+int fntsample_export(struct fntsample_context *ctx,
+    enum fntsample_export_format format, FILE *out);
+
+#endif /* LIBFNTSAMPLE_H_ */
@@ -3,7 +3,13 @@
 # Author: Eugeniy Meshcheryakov <eugen@debian.org>
 #
 # This program adds outlines to pdf files.
-# Usage: pdfoutline input.pdf outline.txt out.pdf
+# Usage: pdfoutline [--linearize] input.pdf outline.txt out.pdf
+#
+# With --linearize the result is written as a linearized ("fast web view")
+# PDF with object and cross-reference streams, so that viewers can show the
+# first page and the outline before the whole file is downloaded. The
+# outline is opened with the document, which places it in the first part
+# of the file. This needs qpdf.
 #
 # File given as second argument should contain outline information in
 # form:
@@ -33,12 +39,15 @@
 
 use strict;
 use PDF::API2;
+use File::Basename;
+use File::Temp qw(tempfile);
+use Getopt::Long;
 use Locale::TextDomain('##PACKAGE##', '##LOCALEDIR##');
 use POSIX qw(:locale_h);
 use subs qw(add_outlines);
 
 sub usage() {
-	printf(__"Usage: %s input.pdf outline.txt out.pdf\n", $0);
+	printf(__"Usage: %s [--linearize] input.pdf outline.txt out.pdf\n", $0);
 }
 
 # get first non-empty non-comment line
@@ -88,9 +97,25 @@ sub add_outlines($$$$) {
 	}
 }
 
+# Rewrite 'input' to 'output' as a linearized PDF
+sub linearize($$) {
+	my ($input, $output) = @_;
+
+	system('qpdf', '--linearize', '--object-streams=generate',
+		'--compress-streams=y', $input, $output);
+	# qpdf exits with 3 if it only had warnings
+	if ($? == -1) {
+		die __x("Cannot run qpdf: {error}\n", error => $!);
+	}
+	elsif ($? & 127 || ($? >> 8 != 0 && $? >> 8 != 3)) {
+		die __"qpdf failed to linearize the output\n";
+	}
+}
+
 setlocale(LC_ALL, '');
 
-if ($#ARGV != 2) {
+my $linearize = 0;
+if (!GetOptions('linearize|l' => \$linearize) || $#ARGV != 2) {
 	usage;
 	exit 1;
 }
@@ -102,5 +127,19 @@ my $pdf = PDF::API2->open($inputfile);
 open(OUTLINE, "<", $outlinefile) or die __x("Cannot open outline file '{outlinefile}'", outlinefile => $outlinefile);
 my $line = get_line(*OUTLINE);
 add_outlines($pdf, $pdf->outlines, $line, *OUTLINE) if $line;
-$pdf->saveas($outputfile);
+
+if ($linearize) {
+	# The unlinearized file is written next to the output
+	my ($tmp, $tmpfile) = tempfile(basename($outputfile) . '.XXXXXX',
+		DIR => dirname($outputfile), UNLINK => 1);
+	close($tmp);
+
+	$pdf->preferences(-outlines => 1) if $line;
+	$pdf->saveas($tmpfile);
+	linearize($tmpfile, $outputfile);
+	unlink($tmpfile);
+}
+else {
+	$pdf->saveas($outputfile);
+}
 exit 0;
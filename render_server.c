@@ -0,0 +1,347 @@
+/*
+ * render_server.c
+ *
+ * Every accepted connection is handled by a forked process, which in turn
+ * forks the process running the job. This way the handler can report the
+ * exit status even if the job terminates with exit() or is killed.
+ */
+
+#include "render_server.h"
+
+#include <errno.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+/* Upper limit for the size of a job description */
+#define MAX_REQUEST_SIZE (1024 * 1024)
+
+/* Number of file descriptors passed with a request (stdout and stderr) */
+#define REQUEST_FDS 2
+
+static int read_full(int fd, void *buf, size_t len) {
+  char *p = buf;
+
+  while (len) {
+    ssize_t n = read(fd, p, len);
+
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return -1;
+    p += n;
+    len -= n;
+  }
+  return 0;
+}
+
+static int write_full(int fd, const void *buf, size_t len) {
+  const char *p = buf;
+
+  while (len) {
+    ssize_t n = write(fd, p, len);
+
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return -1;
+    p += n;
+    len -= n;
+  }
+  return 0;
+}
+
+/* Fill socket address, returns -1 if the path is too long */
+static int make_address(struct sockaddr_un *addr, const char *socket_path) {
+  memset(addr, 0, sizeof(*addr));
+  addr->sun_family = AF_UNIX;
+  if (strlen(socket_path) >= sizeof(addr->sun_path)) {
+    fprintf(stderr, "socket path is too long: %s\n", socket_path);
+    return -1;
+  }
+  strcpy(addr->sun_path, socket_path);
+  return 0;
+}
+
+/*
+ * Receive request header (payload length and file descriptors)
+ * followed by the payload. Returns -1 on error.
+ */
+static int receive_request(int conn, int fds[REQUEST_FDS], char **payload,
+    uint32_t *len) {
+  struct msghdr msg;
+  struct iovec iov;
+  union {
+    struct cmsghdr hdr;
+    char buf[CMSG_SPACE(sizeof(int) * REQUEST_FDS)];
+  } control;
+  struct cmsghdr *cmsg;
+
+  memset(&msg, 0, sizeof(msg));
+  iov.iov_base = len;
+  iov.iov_len = sizeof(*len);
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.buf;
+  msg.msg_controllen = sizeof(control.buf);
+
+  if (recvmsg(conn, &msg, 0) != sizeof(*len))
+    return -1;
+
+  cmsg = CMSG_FIRSTHDR(&msg);
+  if (!cmsg || cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS
+      || cmsg->cmsg_len != CMSG_LEN(sizeof(int) * REQUEST_FDS))
+    return -1;
+  memcpy(fds, CMSG_DATA(cmsg), sizeof(int) * REQUEST_FDS);
+
+  if (*len == 0 || *len > MAX_REQUEST_SIZE)
+    return -1;
+
+  *payload = malloc(*len);
+  if (!*payload)
+    return -1;
+
+  if (read_full(conn, *payload, *len) || (*payload)[*len - 1] != '\0') {
+    free(*payload);
+    return -1;
+  }
+  return 0;
+}
+
+/*
+ * Run the job described by the payload ("argc\0cwd\0arg0\0arg1\0...").
+ * Never returns.
+ */
+static void run_job(char *payload, uint32_t len, int fds[REQUEST_FDS],
+    render_job_func job) {
+  char *p = payload, *end = payload + len;
+  const char *cwd;
+  char **argv;
+  int argc, i;
+
+  argc = atoi(p);
+  p += strlen(p) + 1;
+  if (argc <= 0 || p >= end)
+    _exit(1);
+
+  cwd = p;
+  p += strlen(p) + 1;
+
+  argv = calloc(argc + 1, sizeof(*argv));
+  if (!argv)
+    _exit(1);
+
+  for (i = 0; i < argc; i++) {
+    if (p >= end)
+      _exit(1);
+    argv[i] = p;
+    p += strlen(p) + 1;
+  }
+
+  if (dup2(fds[0], STDOUT_FILENO) == -1 || dup2(fds[1], STDERR_FILENO) == -1)
+    _exit(1);
+  close(fds[0]);
+  close(fds[1]);
+
+  if (chdir(cwd)) {
+    perror(cwd);
+    _exit(1);
+  }
+
+  /* exit() and not _exit(), so that stdio buffers are flushed */
+  exit(job(argc, argv));
+}
+
+/* Handle one client connection. Never returns. */
+static void handle_connection(int conn, render_job_func job) {
+  int fds[REQUEST_FDS];
+  char *payload;
+  uint32_t len;
+  pid_t pid;
+  int status;
+  unsigned char result;
+
+  if (receive_request(conn, fds, &payload, &len))
+    _exit(1);
+
+  pid = fork();
+  if (pid == -1)
+    _exit(1);
+  if (pid == 0) {
+    close(conn);
+    run_job(payload, len, fds, job);
+  }
+
+  close(fds[0]);
+  close(fds[1]);
+
+  while (waitpid(pid, &status, 0) == -1) {
+    if (errno != EINTR)
+      _exit(1);
+  }
+
+  if (WIFEXITED(status))
+    result = WEXITSTATUS(status);
+  else result = 128 + WTERMSIG(status);
+
+  write_full(conn, &result, 1);
+  _exit(0);
+}
+
+int run_server(const char *socket_path, unsigned int max_jobs,
+    render_job_func job) {
+  struct sockaddr_un addr;
+  struct stat st;
+  unsigned int running = 0;
+  int sock;
+
+  if (make_address(&addr, socket_path))
+    return -1;
+
+  sock = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (sock == -1) {
+    perror("socket");
+    return -1;
+  }
+
+  /* Remove stale socket left by previous server, but never other files */
+  if (!lstat(socket_path, &st)) {
+    if (!S_ISSOCK(st.st_mode)) {
+      fprintf(stderr, "%s: file exists and is not a socket\n", socket_path);
+      close(sock);
+      return -1;
+    }
+    unlink(socket_path);
+  }
+  if (bind(sock, (struct sockaddr *) &addr, sizeof(addr))
+      || listen(sock, SOMAXCONN)) {
+    perror(socket_path);
+    close(sock);
+    return -1;
+  }
+
+  /* Clients that went away should not kill handlers */
+  signal(SIGPIPE, SIG_IGN);
+
+  for (;;) {
+    int conn;
+    pid_t pid;
+
+    /* Reap finished handlers, wait if too many jobs are running */
+    while (running && waitpid(-1, NULL, running >= max_jobs ? 0 : WNOHANG) > 0)
+      running--;
+
+    conn = accept(sock, NULL, NULL);
+    if (conn == -1) {
+      if (errno == EINTR || errno == ECONNABORTED)
+        continue;
+      perror("accept");
+      break;
+    }
+
+    /* Nothing should be left buffered in the children */
+    fflush(NULL);
+
+    pid = fork();
+    if (pid == 0) {
+      close(sock);
+      handle_connection(conn, job);
+    }
+    if (pid == -1)
+      perror("fork");
+    else running++;
+    close(conn);
+  }
+
+  close(sock);
+  return -1;
+}
+
+int run_client(const char *socket_path, int argc, char **argv) {
+  struct sockaddr_un addr;
+  struct msghdr msg;
+  struct iovec iov;
+  union {
+    struct cmsghdr hdr;
+    char buf[CMSG_SPACE(sizeof(int) * REQUEST_FDS)];
+  } control;
+  struct cmsghdr *cmsg;
+  int fds[REQUEST_FDS] = { STDOUT_FILENO, STDERR_FILENO };
+  char header[16];
+  char *cwd;
+  char *payload, *p;
+  uint32_t len;
+  unsigned char result;
+  int sock, i;
+
+  if (make_address(&addr, socket_path))
+    return -1;
+
+  cwd = getcwd(NULL, 0);
+  if (!cwd) {
+    perror("getcwd");
+    return -1;
+  }
+
+  /* Build the payload */
+  snprintf(header, sizeof(header), "%d", argc);
+  len = strlen(header) + 1 + strlen(cwd) + 1;
+  for (i = 0; i < argc; i++)
+    len += strlen(argv[i]) + 1;
+
+  payload = malloc(len);
+  if (!payload) {
+    free(cwd);
+    return -1;
+  }
+
+  p = stpcpy(payload, header) + 1;
+  p = stpcpy(p, cwd) + 1;
+  for (i = 0; i < argc; i++)
+    p = stpcpy(p, argv[i]) + 1;
+  free(cwd);
+
+  sock = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (sock == -1 || connect(sock, (struct sockaddr *) &addr, sizeof(addr))) {
+    perror(socket_path);
+    free(payload);
+    if (sock != -1)
+      close(sock);
+    return -1;
+  }
+
+  /* Send payload length together with our stdout and stderr */
+  memset(&msg, 0, sizeof(msg));
+  memset(&control, 0, sizeof(control));
+  iov.iov_base = &len;
+  iov.iov_len = sizeof(len);
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.buf;
+  msg.msg_controllen = sizeof(control.buf);
+  cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(int) * REQUEST_FDS);
+  memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * REQUEST_FDS);
+
+  if (sendmsg(sock, &msg, 0) != sizeof(len) || write_full(sock, payload, len)
+      || read_full(sock, &result, 1)) {
+    fprintf(stderr, "%s: communication with the server failed\n",
+        socket_path);
+    free(payload);
+    close(sock);
+    return -1;
+  }
+
+  free(payload);
+  close(sock);
+  return result;
+}
@@ -0,0 +1,35 @@
+/*
+ * render_server.h
+ *
+ * Persistent render server on a local Unix domain socket. The server
+ * process keeps its initialized state (FreeType, fontconfig, label fonts,
+ * UCD data) and forks a child for every job, so jobs start warm and run
+ * concurrently without sharing anything mutable.
+ *
+ * A job is an argument vector, exactly as it would be given on the
+ * command line, together with the working directory and the standard
+ * output and error of the client, which are passed over the socket.
+ * The server replies with a single byte - the exit status of the job.
+ */
+
+#ifndef RENDER_SERVER_H_
+#define RENDER_SERVER_H_
+
+/* Function running a single job. Returns the exit status of the job. */
+typedef int (*render_job_func)(int argc, char **argv);
+
+/*
+ * Listen on 'socket_path' and run jobs, at most 'max_jobs' at a time.
+ * Returns only on error.
+ */
+int run_server(const char *socket_path, unsigned int max_jobs,
+    render_job_func job);
+
+/*
+ * Submit the job described by 'argc'/'argv' to the server listening on
+ * 'socket_path' and wait for it to finish.
+ * Returns the exit status of the job or -1 on communication error.
+ */
+int run_client(const char *socket_path, int argc, char **argv);
+
+#endif /* RENDER_SERVER_H_ */
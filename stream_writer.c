@@ -0,0 +1,157 @@
+/*
+ * stream_writer.c
+ *
+ * The buffer is filled by one thread and drained by the other, both copy
+ * data outside of the lock: the producer owns the free part of the ring,
+ * the writer thread owns the used part.
+ */
+
+#include "stream_writer.h"
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <glib.h>
+
+struct stream_writer {
+  int fd;
+  char *buf;
+  size_t size;
+  size_t head; /* start of the data not written yet */
+  size_t used;
+  bool closing;
+  int error; /* errno of the failed write, 0 if none */
+  GMutex mutex;
+  GCond cond; /* signalled when 'used', 'closing' or 'error' change */
+  GThread *thread;
+};
+
+static int write_full(int fd, const char *p, size_t len) {
+  while (len) {
+    ssize_t n = write(fd, p, len);
+
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n < 0)
+      return -1;
+    if (n == 0) {
+      errno = EIO;
+      return -1;
+    }
+    p += n;
+    len -= n;
+  }
+  return 0;
+}
+
+static gpointer drain(gpointer data) {
+  struct stream_writer *w = data;
+
+  g_mutex_lock(&w->mutex);
+  for (;;) {
+    size_t len;
+    int err;
+
+    while (!w->used && !w->closing)
+      g_cond_wait(&w->cond, &w->mutex);
+    if (!w->used)
+      break;
+
+    /* Write up to the end of the ring, the rest in the next round */
+    len = MIN(w->used, w->size - w->head);
+    g_mutex_unlock(&w->mutex);
+    err = write_full(w->fd, w->buf + w->head, len) ? errno : 0;
+    g_mutex_lock(&w->mutex);
+
+    if (err) {
+      w->error = err;
+      w->used = 0;
+      g_cond_broadcast(&w->cond);
+      break;
+    }
+    w->head = (w->head + len) % w->size;
+    w->used -= len;
+    g_cond_broadcast(&w->cond);
+  }
+  g_mutex_unlock(&w->mutex);
+  return NULL;
+}
+
+struct stream_writer *stream_writer_new(int fd, size_t size) {
+  struct stream_writer *w = calloc(1, sizeof(*w));
+
+  if (!w)
+    return NULL;
+
+  w->buf = malloc(size);
+  if (!w->buf) {
+    free(w);
+    return NULL;
+  }
+
+  w->fd = fd;
+  w->size = size;
+  g_mutex_init(&w->mutex);
+  g_cond_init(&w->cond);
+  w->thread = g_thread_new("stream-writer", drain, w);
+  return w;
+}
+
+int stream_writer_write(struct stream_writer *w, const void *data,
+    size_t len) {
+  const char *p = data;
+  int err;
+
+  g_mutex_lock(&w->mutex);
+  while (len && !w->error) {
+    size_t tail, n;
+
+    while (w->used == w->size && !w->error)
+      g_cond_wait(&w->cond, &w->mutex);
+    if (w->error)
+      break;
+
+    tail = (w->head + w->used) % w->size;
+    n = MIN(len, MIN(w->size - w->used, w->size - tail));
+    g_mutex_unlock(&w->mutex);
+    memcpy(w->buf + tail, p, n);
+    g_mutex_lock(&w->mutex);
+
+    w->used += n;
+    p += n;
+    len -= n;
+    g_cond_broadcast(&w->cond);
+  }
+  err = w->error;
+  g_mutex_unlock(&w->mutex);
+
+  if (err) {
+    errno = err;
+    return -1;
+  }
+  return 0;
+}
+
+int stream_writer_close(struct stream_writer *w) {
+  int err;
+
+  g_mutex_lock(&w->mutex);
+  w->closing = true;
+  g_cond_broadcast(&w->cond);
+  g_mutex_unlock(&w->mutex);
+  g_thread_join(w->thread);
+
+  err = w->error;
+  g_mutex_clear(&w->mutex);
+  g_cond_clear(&w->cond);
+  free(w->buf);
+  free(w);
+
+  if (err) {
+    errno = err;
+    return -1;
+  }
+  return 0;
+}
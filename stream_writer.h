@@ -0,0 +1,36 @@
+/*
+ * stream_writer.h
+ *
+ * Buffered output drained by a separate thread. The renderer copies the
+ * document into a ring buffer and goes on, while the writer thread writes
+ * it to the file descriptor. Rendering waits for slow disks, pipes or
+ * network file systems only when the buffer is full.
+ */
+
+#ifndef STREAM_WRITER_H_
+#define STREAM_WRITER_H_
+
+#include <stddef.h>
+
+struct stream_writer;
+
+/*
+ * Start writing to 'fd' through a buffer of 'size' bytes.
+ * Returns NULL on error.
+ */
+struct stream_writer *stream_writer_new(int fd, size_t size);
+
+/*
+ * Queue 'len' bytes for writing, waiting while the buffer is full.
+ * Returns -1 (with errno set) if writing has failed.
+ */
+int stream_writer_write(struct stream_writer *w, const void *data,
+    size_t len);
+
+/*
+ * Write out the rest of the buffer and free the writer. The file
+ * descriptor is left open. Returns -1 (with errno set) on error.
+ */
+int stream_writer_close(struct stream_writer *w);
+
+#endif /* STREAM_WRITER_H_ */
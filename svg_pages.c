@@ -0,0 +1,379 @@
+/*
+ * svg_pages.c
+ *
+ * The recorded page is replayed into an SVG surface writing to memory,
+ * and the references to the glyph library are inserted before the closing
+ * tag of the document. Outlines in the library are in font units, so each
+ * reference scales and flips its glyph into place.
+ */
+
+#include "svg_pages.h"
+#include "libfntsample.h"
+#include "font_blob.h"
+#include "trace.h"
+#include "config.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <cairo-svg.h>
+#include <glib.h>
+#include <libintl.h>
+#include FT_OUTLINE_H
+
+#define _(str)	dgettext(PACKAGE, str)
+
+/* Pages waiting for a writer, per thread, before drawing waits */
+#define MAX_PENDING_PER_THREAD	2
+
+/* A glyph placed on a page */
+struct glyph_use {
+  unsigned long index;
+  double x;
+  double y;
+  double scale; /* from font units to points */
+};
+
+struct svg_page {
+  unsigned int number;
+  cairo_pattern_t *pattern;
+  struct glyph_use *uses;
+  size_t num_uses;
+};
+
+struct svg_pages {
+  char *base_name;
+  const char *glyphs_href; /* glyph library relative to the pages */
+  unsigned int units_per_em;
+  unsigned long num_glyphs;
+  bool *used_glyphs;
+  GThreadPool *pool;
+  unsigned int num_pages;
+  unsigned int max_pending;
+
+  /* Glyphs of the page being drawn */
+  struct glyph_use *uses;
+  size_t num_uses;
+  size_t size_uses;
+  bool no_memory; /* memory ran out while drawing, pages are missing */
+
+  /*
+   * Recorded pages can be large, the drawing thread waits for the writers
+   * when too many of them are queued.
+   */
+  GMutex lock;
+  GCond page_written;
+  unsigned int pending;
+  bool failed;
+};
+
+/* SVG document being written by cairo */
+struct svg_buffer {
+  unsigned char *data;
+  size_t len;
+  size_t size;
+};
+
+static cairo_status_t write_to_buffer(void *closure, const unsigned char *data,
+    unsigned int length) {
+  struct svg_buffer *buf = closure;
+
+  if (buf->len + length > buf->size) {
+    size_t size = buf->size ? buf->size * 2 : 64 * 1024;
+    unsigned char *new_data;
+
+    while (size < buf->len + length)
+      size *= 2;
+    new_data = realloc(buf->data, size);
+    if (!new_data)
+      return CAIRO_STATUS_NO_MEMORY;
+    buf->data = new_data;
+    buf->size = size;
+  }
+
+  memcpy(buf->data + buf->len, data, length);
+  buf->len += length;
+  return CAIRO_STATUS_SUCCESS;
+}
+
+static void page_failed(struct svg_pages *pages, const char *file_name) {
+  fprintf(stderr, _("failed to write %s\n"), file_name);
+  g_mutex_lock(&pages->lock);
+  pages->failed = true;
+  g_mutex_unlock(&pages->lock);
+}
+
+/* Called by the drawing thread, the error is reported by svg_pages_finish() */
+static void out_of_memory(struct svg_pages *pages) {
+  if (!pages->no_memory)
+    fprintf(stderr, _("out of memory\n"));
+  pages->no_memory = true;
+}
+
+/* Find the closing tag of the document written by cairo */
+static size_t find_document_end(const struct svg_buffer *buf) {
+  static const char end_tag[] = "</svg>";
+  size_t len = sizeof(end_tag) - 1, i;
+
+  for (i = buf->len; i >= len; i--) {
+    if (!memcmp(buf->data + i - len, end_tag, len))
+      return i - len;
+  }
+  return buf->len;
+}
+
+/* Write a single page, called by worker threads */
+static void write_page(gpointer data, gpointer user_data) {
+  struct svg_page *page = data;
+  struct svg_pages *pages = user_data;
+  struct svg_buffer buf = { NULL, 0, 0 };
+  cairo_surface_t *surface;
+  cairo_t *cr;
+  char *file_name;
+  FILE *out;
+  size_t end, i;
+  int err;
+  int64_t start = trace_begin();
+
+  trace_thread_name("svg-page-writer");
+  file_name = g_strdup_printf("%s-%04u.svg", pages->base_name, page->number);
+
+  surface = cairo_svg_surface_create_for_stream(write_to_buffer, &buf,
+      FNTSAMPLE_PAGE_WIDTH, FNTSAMPLE_PAGE_HEIGHT);
+  cr = cairo_create(surface);
+  cairo_set_source(cr, page->pattern);
+  cairo_paint(cr);
+  cairo_destroy(cr);
+  cairo_surface_finish(surface);
+  err = cairo_surface_status(surface) != CAIRO_STATUS_SUCCESS;
+  cairo_surface_destroy(surface);
+  cairo_pattern_destroy(page->pattern);
+
+  end = find_document_end(&buf);
+  out = err || end == buf.len ? NULL : fopen(file_name, "w");
+  if (!out)
+    page_failed(pages, file_name);
+  else {
+    fwrite(buf.data, 1, end, out);
+    fputs("<g>\n", out);
+    for (i = 0; i < page->num_uses; i++) {
+      const struct glyph_use *u = &page->uses[i];
+
+      fprintf(out, "<use xlink:href=\"%s#g%lu\" "
+          "transform=\"matrix(%g 0 0 %g %g %g)\"/>\n", pages->glyphs_href,
+          u->index, u->scale, -u->scale, u->x, u->y);
+    }
+    fputs("</g>\n", out);
+    fwrite(buf.data + end, 1, buf.len - end, out);
+    err = ferror(out);
+    if (fclose(out) || err)
+      page_failed(pages, file_name);
+  }
+
+  trace_end("svg_pages", file_name, start);
+  free(buf.data);
+  free(page->uses);
+  free(page);
+  g_free(file_name);
+
+  g_mutex_lock(&pages->lock);
+  pages->pending--;
+  g_cond_signal(&pages->page_written);
+  g_mutex_unlock(&pages->lock);
+}
+
+struct svg_pages *svg_pages_new(const char *base_name, FT_Face face) {
+  struct svg_pages *pages = calloc(1, sizeof(*pages));
+  const char *slash;
+
+  if (!pages)
+    return NULL;
+
+  pages->base_name = g_strdup(base_name);
+  pages->units_per_em = face->units_per_EM ? face->units_per_EM : 1000;
+  pages->num_glyphs = face->num_glyphs > 0 ? face->num_glyphs : 0;
+  pages->used_glyphs = calloc(pages->num_glyphs + 1, sizeof(bool));
+  if (!pages->used_glyphs) {
+    g_free(pages->base_name);
+    free(pages);
+    return NULL;
+  }
+
+  slash = strrchr(pages->base_name, '/');
+  pages->glyphs_href = g_strdup_printf("%s-glyphs.svg",
+      slash ? slash + 1 : pages->base_name);
+
+  g_mutex_init(&pages->lock);
+  g_cond_init(&pages->page_written);
+  pages->max_pending = g_get_num_processors() * MAX_PENDING_PER_THREAD;
+  pages->pool = g_thread_pool_new(write_page, pages, g_get_num_processors(),
+      FALSE, NULL);
+  return pages;
+}
+
+void svg_pages_add_glyphs(struct svg_pages *pages, const cairo_glyph_t *glyphs,
+    int num_glyphs, const cairo_matrix_t *font_matrix) {
+  int i;
+
+  for (i = 0; i < num_glyphs; i++) {
+    struct glyph_use *u;
+
+    if (glyphs[i].index >= pages->num_glyphs)
+      continue;
+
+    if (pages->num_uses == pages->size_uses) {
+      size_t size = pages->size_uses ? pages->size_uses * 2 : 256;
+      struct glyph_use *uses = realloc(pages->uses, size * sizeof(*uses));
+
+      if (!uses) {
+        out_of_memory(pages);
+        return;
+      }
+      pages->uses = uses;
+      pages->size_uses = size;
+    }
+
+    u = &pages->uses[pages->num_uses++];
+    u->index = glyphs[i].index;
+    u->x = glyphs[i].x;
+    u->y = glyphs[i].y;
+    u->scale = font_matrix->xx / pages->units_per_em;
+    pages->used_glyphs[u->index] = true;
+  }
+}
+
+void svg_pages_end_page(struct svg_pages *pages, cairo_pattern_t *pattern) {
+  struct svg_page *page = malloc(sizeof(*page));
+
+  if (!page) {
+    out_of_memory(pages);
+    svg_pages_skip_page(pages, pattern);
+    return;
+  }
+
+  page->number = ++pages->num_pages;
+  page->pattern = pattern;
+  page->uses = pages->uses;
+  page->num_uses = pages->num_uses;
+
+  pages->uses = NULL;
+  pages->num_uses = 0;
+  pages->size_uses = 0;
+
+  g_mutex_lock(&pages->lock);
+  while (pages->pending >= pages->max_pending)
+    g_cond_wait(&pages->page_written, &pages->lock);
+  pages->pending++;
+  g_mutex_unlock(&pages->lock);
+
+  g_thread_pool_push(pages->pool, page, NULL);
+}
+
+void svg_pages_skip_page(struct svg_pages *pages, cairo_pattern_t *page) {
+  cairo_pattern_destroy(page);
+  pages->num_pages++;
+  pages->num_uses = 0;
+}
+
+static int move_to(const FT_Vector *to, void *user) {
+  FILE *out = user;
+
+  fprintf(out, "M%ld %ld", (long) to->x, (long) to->y);
+  return 0;
+}
+
+static int line_to(const FT_Vector *to, void *user) {
+  FILE *out = user;
+
+  fprintf(out, "L%ld %ld", (long) to->x, (long) to->y);
+  return 0;
+}
+
+static int conic_to(const FT_Vector *control, const FT_Vector *to,
+    void *user) {
+  FILE *out = user;
+
+  fprintf(out, "Q%ld %ld %ld %ld", (long) control->x, (long) control->y,
+      (long) to->x, (long) to->y);
+  return 0;
+}
+
+static int cubic_to(const FT_Vector *control1, const FT_Vector *control2,
+    const FT_Vector *to, void *user) {
+  FILE *out = user;
+
+  fprintf(out, "C%ld %ld %ld %ld %ld %ld", (long) control1->x,
+      (long) control1->y, (long) control2->x, (long) control2->y,
+      (long) to->x, (long) to->y);
+  return 0;
+}
+
+/* Write outlines of all used glyphs, in font units */
+static int write_glyph_library(struct svg_pages *pages, FT_Face face) {
+  static const FT_Outline_Funcs funcs = { move_to, line_to, conic_to,
+      cubic_to, 0, 0 };
+  char *file_name = g_strdup_printf("%s-glyphs.svg", pages->base_name);
+  FILE *out = fopen(file_name, "w");
+  unsigned long i;
+  int err;
+
+  if (!out) {
+    fprintf(stderr, _("failed to write %s\n"), file_name);
+    g_free(file_name);
+    return -1;
+  }
+
+  fputs("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+      "<svg xmlns=\"http://www.w3.org/2000/svg\" version=\"1.1\">\n<defs>\n",
+      out);
+  for (i = 0; i < pages->num_glyphs; i++) {
+    if (!pages->used_glyphs[i])
+      continue;
+
+    fprintf(out, "<path id=\"g%lu\" d=\"", i);
+    if (!FT_Load_Glyph(face, i, FT_LOAD_NO_SCALE)
+        && face->glyph->format == FT_GLYPH_FORMAT_OUTLINE)
+      FT_Outline_Decompose(&face->glyph->outline, &funcs, out);
+    fputs("\"/>\n", out);
+  }
+  fputs("</defs>\n</svg>\n", out);
+
+  err = ferror(out);
+  if (fclose(out) || err) {
+    fprintf(stderr, _("failed to write %s\n"), file_name);
+    err = 1;
+  }
+  g_free(file_name);
+  return err ? -1 : 0;
+}
+
+int svg_pages_finish(struct svg_pages *pages, FT_Library library,
+    const char *file_name, int face_index) {
+  FT_Face face;
+  int status;
+
+  /* Wait for all queued pages */
+  g_thread_pool_free(pages->pool, FALSE, TRUE);
+
+  status = pages->failed || pages->no_memory ? -1 : 0;
+
+  if (font_blob_new_face(library, file_name, face_index, &face)) {
+    fprintf(stderr, _("failed to open font file %s\n"), file_name);
+    status = -1;
+  }
+  else {
+    if (write_glyph_library(pages, face))
+      status = -1;
+    FT_Done_Face(face);
+  }
+
+  g_cond_clear(&pages->page_written);
+  g_mutex_clear(&pages->lock);
+  free(pages->uses);
+  free(pages->used_glyphs);
+  g_free((char *) pages->glyphs_href);
+  g_free(pages->base_name);
+  free(pages);
+  return status;
+}
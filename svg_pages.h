@@ -0,0 +1,51 @@
+/*
+ * svg_pages.h
+ *
+ * Output of every page into its own SVG file. Glyphs of the font are not
+ * drawn into the pages, instead pages reference them with <use> from a
+ * single glyph library file, where every glyph used by the document is
+ * defined once. Pages are recorded by the drawing code and written by
+ * worker threads while the next pages are being drawn.
+ */
+
+#ifndef SVG_PAGES_H_
+#define SVG_PAGES_H_
+
+#include <cairo.h>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+struct svg_pages;
+
+/*
+ * Start writing pages named 'base_name'-NNNN.svg, with the glyph library
+ * in 'base_name'-glyphs.svg. 'face' is the face being drawn.
+ * Returns NULL on error.
+ */
+struct svg_pages *svg_pages_new(const char *base_name, FT_Face face);
+
+/* Add glyphs drawn using 'font_matrix' to the current page */
+void svg_pages_add_glyphs(struct svg_pages *pages, const cairo_glyph_t *glyphs,
+    int num_glyphs, const cairo_matrix_t *font_matrix);
+
+/*
+ * Finish the current page, drawn into the recording 'page', and queue it
+ * for writing. Takes ownership of 'page'.
+ */
+void svg_pages_end_page(struct svg_pages *pages, cairo_pattern_t *page);
+
+/*
+ * Drop the current page instead of writing it, keeping the numbers of
+ * the following pages. Takes ownership of 'page'.
+ */
+void svg_pages_skip_page(struct svg_pages *pages, cairo_pattern_t *page);
+
+/*
+ * Wait until all pages are written, write the glyph library with outlines
+ * of the face 'face_index' of 'file_name' and free 'pages'.
+ * Returns -1 if anything could not be written.
+ */
+int svg_pages_finish(struct svg_pages *pages, FT_Library library,
+    const char *file_name, int face_index);
+
+#endif /* SVG_PAGES_H_ */
@@ -0,0 +1,133 @@
+/*
+ * trace.c
+ *
+ * Spans are written as complete ("X") events as soon as they end, so
+ * the file is written incrementally and the memory use does not grow with
+ * the length of the run. Threads are numbered in the order of their first
+ * event, and named by their first trace_thread_name() call; the thread
+ * opening the trace is the "main" one.
+ */
+
+#include "trace.h"
+
+#include <stdio.h>
+#include <unistd.h>
+#include <glib.h>
+
+static GMutex trace_mutex;
+static FILE *trace_file;
+static gint64 trace_start;
+static int trace_events;
+static int trace_threads;
+
+/* Track number of the thread, 0 if not assigned yet */
+static GPrivate thread_track = G_PRIVATE_INIT(NULL);
+static GPrivate thread_named = G_PRIVATE_INIT(NULL);
+
+static void name_thread(const char *name);
+
+int trace_open(const char *file_name) {
+  FILE *f = fopen(file_name, "w");
+
+  if (!f)
+    return -1;
+
+  g_mutex_lock(&trace_mutex);
+  trace_start = g_get_monotonic_time();
+  trace_events = 0;
+  fputs("[\n", f);
+  trace_file = f;
+  name_thread("main");
+  g_mutex_unlock(&trace_mutex);
+  return 0;
+}
+
+int trace_close(void) {
+  int err;
+
+  g_mutex_lock(&trace_mutex);
+  if (!trace_file) {
+    g_mutex_unlock(&trace_mutex);
+    return 0;
+  }
+
+  fputs("\n]\n", trace_file);
+  err = ferror(trace_file) | fclose(trace_file);
+  trace_file = NULL;
+  g_mutex_unlock(&trace_mutex);
+  return err ? -1 : 0;
+}
+
+int64_t trace_begin(void) {
+  return trace_file ? g_get_monotonic_time() : 0;
+}
+
+/* Print 's' as a JSON string */
+static void print_string(const char *s) {
+  putc('"', trace_file);
+  for (; *s; s++) {
+    if (*s == '"' || *s == '\\')
+      fprintf(trace_file, "\\%c", *s);
+    else if ((unsigned char) *s < 0x20)
+      fprintf(trace_file, "\\u%04x", *s);
+    else putc(*s, trace_file);
+  }
+  putc('"', trace_file);
+}
+
+/* Track of the calling thread, trace_mutex should be held */
+static int get_track(void) {
+  int track = GPOINTER_TO_INT(g_private_get(&thread_track));
+
+  if (!track) {
+    track = ++trace_threads;
+    g_private_set(&thread_track, GINT_TO_POINTER(track));
+  }
+  return track;
+}
+
+/* Start a new event, trace_mutex should be held */
+static void print_event_start(void) {
+  if (trace_events++)
+    fputs(",\n", trace_file);
+}
+
+void trace_end(const char *cat, const char *name, int64_t start) {
+  gint64 now;
+
+  if (!start)
+    return;
+
+  now = g_get_monotonic_time();
+  g_mutex_lock(&trace_mutex);
+  if (trace_file && start >= trace_start) {
+    print_event_start();
+    fputs("{\"name\":", trace_file);
+    print_string(name);
+    fputs(",\"cat\":", trace_file);
+    print_string(cat);
+    fprintf(trace_file, ",\"ph\":\"X\",\"ts\":%" G_GINT64_FORMAT
+        ",\"dur\":%" G_GINT64_FORMAT ",\"pid\":%ld,\"tid\":%d}",
+        start - trace_start, now - start, (long) getpid(), get_track());
+  }
+  g_mutex_unlock(&trace_mutex);
+}
+
+/* Name the track of the calling thread, trace_mutex should be held */
+static void name_thread(const char *name) {
+  if (g_private_get(&thread_named))
+    return;
+
+  g_private_set(&thread_named, GINT_TO_POINTER(1));
+  print_event_start();
+  fputs("{\"name\":\"thread_name\",\"ph\":\"M\",\"args\":{\"name\":", trace_file);
+  print_string(name);
+  fprintf(trace_file, "},\"pid\":%ld,\"tid\":%d}", (long) getpid(), get_track());
+}
+
+void trace_thread_name(const char *name) {
+  g_mutex_lock(&trace_mutex);
+  if (trace_file)
+    name_thread(name);
+  g_mutex_unlock(&trace_mutex);
+}
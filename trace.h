@@ -0,0 +1,32 @@
+/*
+ * trace.h
+ *
+ * Spans of work in the Chrome trace event format, which can be opened in
+ * Perfetto or chrome://tracing. Tracing is process-wide, spans from all
+ * threads go to one file, every thread on its own track.
+ */
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include <stdint.h>
+
+/* Start writing spans to 'file_name'. Returns -1 on error. */
+int trace_open(const char *file_name);
+
+/* Finish the trace file. Returns -1 on write error. */
+int trace_close(void);
+
+/* Start of a span, or 0 if tracing is off */
+int64_t trace_begin(void);
+
+/*
+ * Record the span 'name' of category 'cat', which started at 'start'
+ * (returned by trace_begin()) and ends now.
+ */
+void trace_end(const char *cat, const char *name, int64_t start);
+
+/* Name the track of the calling thread, if it has no name yet */
+void trace_thread_name(const char *name);
+
+#endif /* TRACE_H_ */
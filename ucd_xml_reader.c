@@ -9,9 +9,18 @@
  */
 
 #include "ucd_xml_reader.h"
+#include "trace.h"
 
 #include <string.h>
 #include <ctype.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <glib.h>
+
+/* Do not start a thread for less than this amount of XML */
+#define CHUNK_SIZE_MIN (256 * 1024)
 
 const struct XmlTag xmlTags = { "comment_line", "subtitle", "title", "file_comment",
     "notice_line", "char_entry", "formalalias_line", "block_header", "block_subheader",
@@ -27,7 +36,7 @@ char *trimWhitespace(char *str) {
   char *p = str;
   size_t l = strlen(p);
 
-  while (isspace(p[l - 1])) {
+  while (l > 0 && isspace((unsigned char) p[l - 1])) {
     p[--l] = 0;
   }
   while (*p && isspace(*p)) {
@@ -38,434 +47,895 @@ char *trimWhitespace(char *str) {
   return str;
 }
 
-/* Return new allocated string with the given content */
-char *allocateString(const xmlChar *str) {
-  return strdup((char *) str);
+/* Arrays of the data being built, with their allocated sizes */
+struct ucdBuilder {
+  struct ucd_data *ucd;
+  uint32_t blocksSize;
+  uint32_t subheadersSize;
+  uint32_t charsSize;
+  uint32_t tagsSize;
+  uint32_t attrsSize;
+  uint32_t stringsSize;
+  int failed; /* an array could not be grown, the data is incomplete */
+};
+
+/*
+ * Make room for 'extra' more elements of the array with 'count' elements.
+ * If that fails, 'failed' of the builder is set and the array is returned
+ * unchanged.
+ */
+static void *growArray(struct ucdBuilder *b, void *array, uint32_t count, uint32_t *size,
+    size_t extra, size_t elemSize) {
+  if (count + extra > *size) {
+    size_t newSize = *size ? *size : 64;
+    void *newArray;
+
+    while (newSize < count + extra)
+      newSize *= 2;
+    if (newSize >= UCD_NO_STRING) {
+      fprintf(stderr, "UCD data is too large\n");
+      b->failed = 1;
+      return array;
+    }
+    newArray = realloc(array, newSize * elemSize);
+    if (!newArray) {
+      b->failed = 1;
+      return array;
+    }
+    array = newArray;
+    *size = newSize;
+  }
+  return array;
 }
 
-/* Create empty structures defined in the header file */
-static struct header_block *emptyHeaderBlock(void) {
-  struct header_block *headBck = malloc(sizeof(*headBck));
-  headBck->outer_tags = NULL;
-  headBck->chars = NULL;
-  headBck->subheaders = NULL;
-  headBck->name = NULL;
-  headBck->next = NULL;
-  headBck->start = 0L;
-  headBck->end = 0L;
-  return headBck;
+/*
+ * Add new elements to the end of the arrays. Pointers to the elements stay
+ * valid until another element is added to the same array. NULL (or
+ * UCD_NO_STRING for strings) is returned if memory runs out.
+ */
+static struct ucd_block *newBlock(struct ucdBuilder *b) {
+  struct ucd_data *ucd = b->ucd;
+  struct ucd_block *block;
+
+  ucd->blocks = growArray(b, ucd->blocks, ucd->n_blocks, &b->blocksSize, 1,
+      sizeof(*ucd->blocks));
+  if (b->failed)
+    return NULL;
+  block = &ucd->blocks[ucd->n_blocks++];
+  block->start = 0;
+  block->end = 0;
+  block->name = UCD_NO_STRING;
+  block->first_tag = ucd->n_tags;
+  block->n_tags = 0;
+  block->first_subheader = ucd->n_subheaders;
+  block->n_subheaders = 0;
+  block->first_char = ucd->n_chars;
+  block->n_chars = 0;
+  return block;
 }
 
-static struct subheader_block *emptySubHeaderBlock(void) {
-  struct subheader_block *subBck = malloc(sizeof(*subBck));
-  subBck->start = -1UL;
-  subBck->end = -1UL;
-  subBck->name = NULL;
-  subBck->outer_tags = NULL;
-  subBck->chars = NULL;
-  subBck->next = NULL;
-  return subBck;
+static struct ucd_subheader *newSubheader(struct ucdBuilder *b) {
+  struct ucd_data *ucd = b->ucd;
+  struct ucd_subheader *sub;
+
+  ucd->subheaders = growArray(b, ucd->subheaders, ucd->n_subheaders, &b->subheadersSize, 1,
+      sizeof(*ucd->subheaders));
+  if (b->failed)
+    return NULL;
+  sub = &ucd->subheaders[ucd->n_subheaders++];
+  sub->start = UINT32_MAX;
+  sub->end = UINT32_MAX;
+  sub->name = UCD_NO_STRING;
+  sub->first_tag = ucd->n_tags;
+  sub->n_tags = 0;
+  sub->first_char = ucd->n_chars;
+  sub->n_chars = 0;
+  return sub;
 }
 
-static struct tag_attr *emptyTagAttr(void) {
-  struct tag_attr *tagAttr = malloc(sizeof(*tagAttr));
-  tagAttr->name = NULL;
-  tagAttr->value = NULL;
-  tagAttr->next = NULL;
-  return tagAttr;
+static struct ucd_char *newChar(struct ucdBuilder *b) {
+  struct ucd_data *ucd = b->ucd;
+  struct ucd_char *entry;
+
+  ucd->chars = growArray(b, ucd->chars, ucd->n_chars, &b->charsSize, 1, sizeof(*ucd->chars));
+  if (b->failed)
+    return NULL;
+  entry = &ucd->chars[ucd->n_chars++];
+  entry->cp = 0;
+  entry->name = UCD_NO_STRING;
+  entry->type = UCD_NO_STRING;
+  entry->first_tag = ucd->n_tags;
+  entry->n_tags = 0;
+  return entry;
 }
 
-static struct simple_tag *emptySimpleTag(void) {
-  struct simple_tag *smplTag = malloc(sizeof(*smplTag));
-  smplTag->name = NULL;
-  smplTag->content = NULL;
-  smplTag->info = NULL;
-  smplTag->next = NULL;
-  return smplTag;
+static struct ucd_tag *newTag(struct ucdBuilder *b, enum ucd_tag_kind kind) {
+  struct ucd_data *ucd = b->ucd;
+  struct ucd_tag *tag;
+
+  ucd->tags = growArray(b, ucd->tags, ucd->n_tags, &b->tagsSize, 1, sizeof(*ucd->tags));
+  if (b->failed)
+    return NULL;
+  tag = &ucd->tags[ucd->n_tags++];
+  tag->kind = kind;
+  tag->content = UCD_NO_STRING;
+  tag->first_attr = ucd->n_attrs;
+  tag->n_attrs = 0;
+  return tag;
 }
 
-static struct char_entry *emptyCharEntry(void) {
-  struct char_entry *entry = malloc(sizeof(*entry));
-  entry->name = NULL;
-  entry->type = NULL;
-  entry->cp = 0L;
-  entry->char_info = NULL;
-  entry->next = NULL;
-  return entry;
+static struct ucd_attr *newAttr(struct ucdBuilder *b) {
+  struct ucd_data *ucd = b->ucd;
+
+  ucd->attrs = growArray(b, ucd->attrs, ucd->n_attrs, &b->attrsSize, 1, sizeof(*ucd->attrs));
+  if (b->failed)
+    return NULL;
+  return &ucd->attrs[ucd->n_attrs++];
+}
+
+/* Copy the string to the string table, returns its offset */
+static uint32_t addString(struct ucdBuilder *b, const xmlChar *str) {
+  struct ucd_data *ucd = b->ucd;
+  size_t len = strlen((const char *) str) + 1;
+  uint32_t offset = ucd->strings_len;
+
+  ucd->strings = growArray(b, ucd->strings, ucd->strings_len, &b->stringsSize, len, 1);
+  if (b->failed)
+    return UCD_NO_STRING;
+  memcpy(ucd->strings + offset, str, len);
+  ucd->strings_len += len;
+  return offset;
 }
 
-/* Parse an XML tag to the structure */
-static void parseSimpleTag(struct simple_tag *simpleTag, xmlNode *node, const char *tag,
-    const char *attr) {
-  struct tag_attr *tagAttr;
-  struct tag_attr *prevTagAttr = NULL;
+/* Value of the attribute, stored in the string table */
+static uint32_t addAttrValue(struct ucdBuilder *b, const xmlAttr *attr) {
+  return attr->children ? addString(b, attr->children->content) : addString(b, BAD_CAST "");
+}
+
+/* Kind of the tag with the given name, returns -1 for unknown tags */
+static int tagKind(const xmlNode *node, const char **contentAttr) {
+  static const struct {
+    const char *const *tag;
+    const char *const *attr;
+    enum ucd_tag_kind kind;
+  } kinds[] = {
+      { &xmlTags.NOTICE_LINE, NULL, UCD_NOTICE_LINE },
+      { &xmlTags.COMMENT_LINE, &xmlAttrs.CONTENT, UCD_COMMENT_LINE },
+      { &xmlTags.CROSS_REF, &xmlAttrs.REF, UCD_CROSS_REF },
+      { &xmlTags.ALIAS_LINE, &xmlAttrs.NAME, UCD_ALIAS_LINE },
+      { &xmlTags.FORMALALIAS_LINE, &xmlAttrs.NAME, UCD_FORMALALIAS_LINE },
+      { &xmlTags.VARIATION_LINE, &xmlAttrs.VARIATION, UCD_VARIATION_LINE },
+      { &xmlTags.DECOMPOSITION, &xmlAttrs.DECOMP, UCD_DECOMPOSITION },
+      { &xmlTags.COMPAT_MAPPING, &xmlAttrs.COMPAT, UCD_COMPAT_MAPPING } };
+  size_t i;
+
+  for (i = 0; i < sizeof(kinds) / sizeof(kinds[0]); i++) {
+    if (strcmp((const char *) node->name, *kinds[i].tag) == 0) {
+      *contentAttr = kinds[i].attr ? *kinds[i].attr : NULL;
+      return kinds[i].kind;
+    }
+  }
+  return -1;
+}
+
+/*
+ * Parse an XML tag to the structure. Only notice lines, comment lines and
+ * cross references are accepted outside of char entries ('charTag' false).
+ * Returns 1 if the tag was added.
+ */
+static int parseSimpleTag(struct ucdBuilder *b, xmlNode *node, int charTag) {
+  const char *contentAttr;
+  int kind = tagKind(node, &contentAttr);
+  struct ucd_tag *tag;
   xmlAttr *attrs;
-  /* Tag name */
-  simpleTag->name = tag;
+
+  if (kind < 0 || (!charTag && kind != UCD_NOTICE_LINE && kind != UCD_COMMENT_LINE
+      && kind != UCD_CROSS_REF))
+    return 0;
+
+  tag = newTag(b, kind);
+  if (!tag)
+    return 0;
 
   /* If notice line, handle it separately */
-  if (strcmp(tag, xmlTags.NOTICE_LINE) == 0) {
-    simpleTag->content = trimWhitespace(allocateString(xmlNodeGetContent(node)));
-    if (simpleTag->content == NULL)
-      printf("Error in copying a notice line tag\n");
+  if (kind == UCD_NOTICE_LINE) {
+    xmlChar *content = xmlNodeGetContent(node);
+
+    if (content) {
+      tag->content = addString(b, BAD_CAST trimWhitespace((char *) content));
+      xmlFree(content);
+    }
   }
 
   /* Parse content */
   for (attrs = node->properties; attrs; attrs = attrs->next) {
+    struct ucd_attr *attr;
+
     if (attrs->type != XML_ATTRIBUTE_NODE) {
       continue;
     }
 
-    if (attr && strcmp((const char *) attrs->name, attr) == 0) {
-      simpleTag->content = allocateString(attrs->children->content);
-      if (simpleTag->content == NULL)
-        printf("Error in copying a simple tag\n");
+    if (contentAttr && strcmp((const char *) attrs->name, contentAttr) == 0) {
+      tag->content = addAttrValue(b, attrs);
     }
     else {
-      tagAttr = emptyTagAttr();
-
-      /* Connect previous attribute */
-      if (prevTagAttr != NULL) {
-        prevTagAttr->next = tagAttr;
-      }
-      prevTagAttr = tagAttr;
-
-      /* Add the first info */
-      if (simpleTag->info == NULL) {
-        simpleTag->info = tagAttr;
-      }
-
-      /* Parse tag's additional attribute - name */
-      tagAttr->name = allocateString(attrs->name);
-      if (tagAttr->name == NULL)
-        printf("Error in copying a simple tag attr name\n");
-
-      /* Parse tag's additional attribute - value */
-      tagAttr->value = allocateString(attrs->children->content);
-      if (tagAttr->value == NULL)
-        printf("Error in copying a simple tag attr value\n");
+      /* Tag's additional attribute */
+      attr = newAttr(b);
+      if (!attr)
+        break;
+      attr->name = addString(b, attrs->name);
+      attr->value = addAttrValue(b, attrs);
+      tag->n_attrs++;
     }
   }
+  return 1;
 }
 
 /* Parse char entry and its whole content */
-static void parseCharEntry(struct char_entry *entry, xmlNode *charNode) {
+static struct ucd_char *parseCharEntry(struct ucdBuilder *b, xmlNode *charNode) {
+  struct ucd_char *entry = newChar(b);
   xmlNode *node = NULL;
   xmlAttr *attrs = NULL;
 
-  /* Simple tag pointers */
-  struct simple_tag* currSmpl = NULL;
-  struct simple_tag* prevSmpl = NULL;
+  if (!entry)
+    return NULL;
 
   /* Get attributes of the char entry */
   for (attrs = charNode->properties; attrs; attrs = attrs->next) {
-    if (attrs->type != XML_ATTRIBUTE_NODE) {
+    if (attrs->type != XML_ATTRIBUTE_NODE || !attrs->children) {
       continue;
     }
 
     if (strcmp((const char *) attrs->name, xmlAttrs.NAME) == 0) {
-      entry->name = allocateString(attrs->children->content);
-      if (entry->name == NULL) {
-        printf("Error in copying char entry name\n");
-      }
+      entry->name = addAttrValue(b, attrs);
     }
     else if (strcmp((const char *) attrs->name, xmlAttrs.TYPE) == 0) {
-      entry->type = allocateString(attrs->children->content);
-      if (entry->type == NULL) {
-        printf("Error in copying char entry type\n");
-      }
+      entry->type = addAttrValue(b, attrs);
     }
     else if (strcmp((const char *) attrs->name, xmlAttrs.CODE_POINT) == 0) {
-      if (sscanf((const char *) attrs->children->content, "%lX", &entry->cp) != 1) {
-        printf("Parse error in char entry code point\n");
+      unsigned long cp;
+
+      if (sscanf((const char *) attrs->children->content, "%lX", &cp) != 1) {
+        fprintf(stderr, "Parse error in char entry code point\n");
       }
+      else entry->cp = cp;
     }
   }
 
   /* Iterate through the char entry children */
   for (node = charNode->children; node; node = node->next) {
     /* Continue only with a node */
-    if (node->type != XML_ELEMENT_NODE) {
-      continue;
+    if (node->type == XML_ELEMENT_NODE) {
+      entry->n_tags += parseSimpleTag(b, node, 1);
     }
+  }
+  return entry;
+}
 
-    currSmpl = emptySimpleTag();
+static int isElement(const xmlNode *node, const char *name) {
+  return node->type == XML_ELEMENT_NODE && strcmp((const char *) node->name, name) == 0;
+}
 
-    /* Connect new simple tag with the previous one */
-    if (prevSmpl != NULL) {
-      prevSmpl->next = currSmpl;
-    }
-    prevSmpl = currSmpl;
+/*
+ * Parse the content of a subheader block. Its own tags are parsed first,
+ * so that they are adjacent in the tags array.
+ */
+static void parseSubHeaderContent(struct ucdBuilder *b, xmlNode *content,
+    uint32_t subIndex) {
+  struct ucd_subheader *sub = &b->ucd->subheaders[subIndex];
+  xmlNode *node = NULL;
 
-    /* Assign the first simple tag */
-    if (entry->char_info == NULL) {
-      entry->char_info = currSmpl;
+  for (node = content; node; node = node->next) {
+    if (node->type == XML_ELEMENT_NODE && !isElement(node, xmlTags.CHAR_ENTRY)) {
+      sub->n_tags += parseSimpleTag(b, node, 0);
     }
+  }
 
-    if (strcmp((const char *) node->name, xmlTags.NOTICE_LINE) == 0) {
-      parseSimpleTag(currSmpl, node, xmlTags.NOTICE_LINE, NULL);
-    }
-    else if (strcmp((const char *) node->name, xmlTags.CROSS_REF) == 0) {
-      parseSimpleTag(currSmpl, node, xmlTags.CROSS_REF, xmlAttrs.REF);
-    }
-    else if (strcmp((const char *) node->name, xmlTags.ALIAS_LINE) == 0) {
-      parseSimpleTag(currSmpl, node, xmlTags.ALIAS_LINE, xmlAttrs.NAME);
-    }
-    else if (strcmp((const char *) node->name, xmlTags.FORMALALIAS_LINE) == 0) {
-      parseSimpleTag(currSmpl, node, xmlTags.FORMALALIAS_LINE, xmlAttrs.NAME);
-    }
-    else if (strcmp((const char *) node->name, xmlTags.VARIATION_LINE) == 0) {
-      parseSimpleTag(currSmpl, node, xmlTags.VARIATION_LINE, xmlAttrs.VARIATION);
-    }
-    else if (strcmp((const char *) node->name, xmlTags.DECOMPOSITION) == 0) {
-      parseSimpleTag(currSmpl, node, xmlTags.DECOMPOSITION, xmlAttrs.DECOMP);
-    }
-    else if (strcmp((const char *) node->name, xmlTags.COMPAT_MAPPING) == 0) {
-      parseSimpleTag(currSmpl, node, xmlTags.COMPAT_MAPPING, xmlAttrs.COMPAT);
-    }
-    else if (strcmp((const char *) node->name, xmlTags.COMMENT_LINE) == 0) {
-      parseSimpleTag(currSmpl, node, xmlTags.COMMENT_LINE, xmlAttrs.CONTENT);
-    }
+  sub->first_char = b->ucd->n_chars;
+  for (node = content; node; node = node->next) {
+    if (isElement(node, xmlTags.CHAR_ENTRY)) {
+      struct ucd_char *entry = parseCharEntry(b, node);
 
-  } /* end for */
+      if (!entry)
+        return;
+      /* Update the first and the last char indicators */
+      if (sub->start == UINT32_MAX) {
+        sub->start = entry->cp;
+      }
+      sub->end = entry->cp;
+      sub->n_chars++;
+    }
+  }
 }
 
-/* Parse the content of a subheader block */
-static void parseSubHeaderContent(xmlNode *content, struct subheader_block *block) {
+/*
+ * Parse the content of a header block: its tags, subheaders and char entries
+ * outside of subheaders, each in a separate pass.
+ */
+static void parseBlockHeaderContent(struct ucdBuilder *b, xmlNode *blockContent,
+    uint32_t blockIndex) {
+  struct ucd_data *ucd = b->ucd;
   xmlNode *node = NULL;
+  xmlAttr *attrs = NULL;
 
-  /* Simple tags pointers */
-  struct simple_tag* currSmpl = NULL;
-  struct simple_tag* prevSmpl = NULL;
+  for (node = blockContent; node; node = node->next) {
+    if (node->type == XML_ELEMENT_NODE && !isElement(node, xmlTags.BLOCK_SUBHEADER)
+        && !isElement(node, xmlTags.CHAR_ENTRY)) {
+      ucd->blocks[blockIndex].n_tags += parseSimpleTag(b, node, 0);
+    }
+  }
 
-  /* Char entries pointers */
-  struct char_entry* currChar = NULL;
-  struct char_entry* prevChar = NULL;
+  ucd->blocks[blockIndex].first_subheader = ucd->n_subheaders;
+  for (node = blockContent; node; node = node->next) {
+    struct ucd_subheader *sub;
 
-  /* Iterate through block subheader children */
-  for (node = content; node; node = node->next) {
-    /* Continue only with a node */
-    if (node->type != XML_ELEMENT_NODE) {
+    if (!isElement(node, xmlTags.BLOCK_SUBHEADER))
       continue;
-    }
 
-    if (strcmp((const char *) node->name, xmlTags.CHAR_ENTRY) == 0) {
-      currChar = emptyCharEntry();
+    sub = newSubheader(b);
+    if (!sub)
+      return;
 
-      /* Connect new char entry with the previous one */
-      if (prevChar != NULL) {
-        prevChar->next = currChar;
-      }
-      prevChar = currChar;
-
-      /* Assign the first char entry */
-      if (block->chars == NULL) {
-        block->chars = currChar;
+    /* Get attributes of the block subheader */
+    for (attrs = node->properties; attrs; attrs = attrs->next) {
+      if (attrs->type == XML_ATTRIBUTE_NODE && strcmp((const char *) attrs->name, xmlAttrs.NAME) == 0) {
+        sub->name = addAttrValue(b, attrs);
       }
+    }
 
-      parseCharEntry(currChar, node);
+    /* Parse subheader content */
+    parseSubHeaderContent(b, node->children, ucd->n_subheaders - 1);
+    ucd->blocks[blockIndex].n_subheaders++;
+  }
 
-      /* Update the first and the last char indicators */
-      if (block->start == -1UL) {
-        block->start = currChar->cp;
-      }
-      block->end = currChar->cp;
+  ucd->blocks[blockIndex].first_char = ucd->n_chars;
+  for (node = blockContent; node; node = node->next) {
+    if (isElement(node, xmlTags.CHAR_ENTRY)) {
+      parseCharEntry(b, node);
+      ucd->blocks[blockIndex].n_chars++;
     }
-    else {
-      currSmpl = emptySimpleTag();
+  }
+}
 
-      /* Connect new simple tag with the previous one */
-      if (prevSmpl != NULL) {
-        prevSmpl->next = currSmpl;
-      }
-      prevSmpl = currSmpl;
+/*
+ * Create a convenient representation of the XML file. Put all blocks into the array,
+ * assign character entries and other useful information to them.
+ */
+struct ucd_data *parse_ucd_from_xml(const xmlNode *rootChildren) {
+  struct ucdBuilder b;
+  const xmlNode *node = NULL;
+  xmlAttr *attrs = NULL;
+
+  memset(&b, 0, sizeof(b));
+  b.ucd = calloc(1, sizeof(*b.ucd));
+  if (!b.ucd)
+    return NULL;
+
+  /* Iterate through root children and ignore all tags except for block headers */
+  for (node = rootChildren; node; node = node->next) {
+    struct ucd_block *block;
+    unsigned long value;
+
+    if (!isElement(node, xmlTags.BLOCK_HEADER))
+      continue;
+
+    block = newBlock(&b);
+    if (!block)
+      break;
 
-      /* Assign the first simple tag */
-      if (block->outer_tags == NULL) {
-        block->outer_tags = currSmpl;
+    /* Get attributes of the block header */
+    for (attrs = node->properties; attrs; attrs = attrs->next) {
+      /* Continue only with an attribute */
+      if (attrs->type != XML_ATTRIBUTE_NODE || !attrs->children) {
+        continue;
       }
 
-      if (strcmp((const char *) node->name, xmlTags.NOTICE_LINE) == 0) {
-        parseSimpleTag(currSmpl, node, xmlTags.NOTICE_LINE, NULL);
+      if (strcmp((const char *) attrs->name, xmlAttrs.BLOCK_START) == 0) {
+        if (sscanf((const char *) attrs->children->content, "%lX", &value) != 1) {
+          fprintf(stderr, "Parse error in block header start\n");
+        }
+        else block->start = value;
       }
-      else if (strcmp((const char *) node->name, xmlTags.CROSS_REF) == 0) {
-        parseSimpleTag(currSmpl, node, xmlTags.CROSS_REF, xmlAttrs.REF);
+      else if (strcmp((const char *) attrs->name, xmlAttrs.BLOCK_END) == 0) {
+        if (sscanf((const char *) attrs->children->content, "%lX", &value) != 1) {
+          fprintf(stderr, "Parse error in block header end\n");
+        }
+        else block->end = value;
       }
-      else if (strcmp((const char *) node->name, xmlTags.COMMENT_LINE) == 0) {
-        parseSimpleTag(currSmpl, node, xmlTags.COMMENT_LINE, xmlAttrs.CONTENT);
+      else if (strcmp((const char *) attrs->name, xmlAttrs.NAME) == 0) {
+        block->name = addAttrValue(&b, attrs);
       }
+    }
 
-    } /* end else */
-  } /* end for */
+    parseBlockHeaderContent(&b, node->children, b.ucd->n_blocks - 1);
+  }
+
+  if (b.failed) {
+    free_ucd_data(b.ucd);
+    return NULL;
+  }
+  return b.ucd;
 }
 
-/* Parse the content of a header block */
-static void parseBlockHeaderContent(xmlNode *block_content, struct header_block *block) {
-  xmlNode *node = NULL;
-  xmlAttr *attrs = NULL;
+void free_ucd_data(struct ucd_data *ucd) {
+  if (!ucd)
+    return;
+
+  free(ucd->blocks);
+  free(ucd->subheaders);
+  free(ucd->chars);
+  free(ucd->tags);
+  free(ucd->attrs);
+  free(ucd->strings);
+  free(ucd);
+}
+
+/* Blocks are sorted by their start code points */
+const struct ucd_block *find_ucd_block(const struct ucd_data *ucd, unsigned long cp) {
+  uint32_t lo = 0, hi = ucd->n_blocks;
+
+  while (lo < hi) {
+    uint32_t mid = lo + (hi - lo) / 2;
 
-  /* Subheader pointers */
-  struct subheader_block* blockSub = NULL;
-  struct subheader_block* prevSub = NULL;
+    if (ucd->blocks[mid].start <= cp)
+      lo = mid + 1;
+    else hi = mid;
+  }
+  if (lo > 0 && cp <= ucd->blocks[lo - 1].end)
+    return &ucd->blocks[lo - 1];
+  return NULL;
+}
 
-  /* Simple tags pointers */
-  struct simple_tag* currSmpl = NULL;
-  struct simple_tag* prevSmpl = NULL;
+static int compareBlocks(const void *a, const void *b) {
+  const struct ucd_block *blockA = a, *blockB = b;
 
-  /* Char entries pointers */
-  struct char_entry* currChar = NULL;
-  struct char_entry* prevChar = NULL;
+  return blockA->start < blockB->start ? -1 : blockA->start > blockB->start;
+}
 
-  /* Iterate through block header children */
-  for (node = block_content; node; node = node->next) {
-    /* Continue only with a node */
-    if (node->type != XML_ELEMENT_NODE) {
-      continue;
+/* Sort the blocks, in case the file does not list them in order */
+static void sortBlocks(struct ucd_data *ucd) {
+  uint32_t i;
+
+  for (i = 1; i < ucd->n_blocks; i++) {
+    if (ucd->blocks[i].start < ucd->blocks[i - 1].start) {
+      qsort(ucd->blocks, ucd->n_blocks, sizeof(*ucd->blocks), compareBlocks);
+      return;
     }
+  }
+}
 
-    if (strcmp((const char *) node->name, xmlTags.BLOCK_SUBHEADER) == 0) {
-      blockSub = emptySubHeaderBlock();
+static uint32_t rebaseString(uint32_t s, uint32_t base) {
+  return s == UCD_NO_STRING ? s : s + base;
+}
 
-      /* Connect new block subheader with the previous one */
-      if (prevSub != NULL) {
-        prevSub->next = blockSub;
-      }
-      prevSub = blockSub;
+/*
+ * Append 'part' to 'ucd', shifting its indices by the sizes of the arrays
+ * of 'ucd'. 'part' is freed. Returns -1 if memory runs out, 'ucd' is
+ * unchanged then.
+ */
+static int appendUcdData(struct ucd_data *ucd, struct ucd_data *part) {
+  struct ucdBuilder b;
+  uint32_t i;
+
+  memset(&b, 0, sizeof(b));
+  b.ucd = ucd;
+  b.blocksSize = ucd->n_blocks;
+  b.subheadersSize = ucd->n_subheaders;
+  b.charsSize = ucd->n_chars;
+  b.tagsSize = ucd->n_tags;
+  b.attrsSize = ucd->n_attrs;
+  b.stringsSize = ucd->strings_len;
+
+  ucd->blocks = growArray(&b, ucd->blocks, ucd->n_blocks, &b.blocksSize, part->n_blocks,
+      sizeof(*ucd->blocks));
+  ucd->subheaders = growArray(&b, ucd->subheaders, ucd->n_subheaders, &b.subheadersSize,
+      part->n_subheaders, sizeof(*ucd->subheaders));
+  ucd->chars = growArray(&b, ucd->chars, ucd->n_chars, &b.charsSize, part->n_chars,
+      sizeof(*ucd->chars));
+  ucd->tags = growArray(&b, ucd->tags, ucd->n_tags, &b.tagsSize, part->n_tags,
+      sizeof(*ucd->tags));
+  ucd->attrs = growArray(&b, ucd->attrs, ucd->n_attrs, &b.attrsSize, part->n_attrs,
+      sizeof(*ucd->attrs));
+  ucd->strings = growArray(&b, ucd->strings, ucd->strings_len, &b.stringsSize,
+      part->strings_len, 1);
+  if (b.failed) {
+    free_ucd_data(part);
+    return -1;
+  }
 
-      /* Assign the first subheader block */
-      if (block->subheaders == NULL) {
-        block->subheaders = blockSub;
-      }
+  for (i = 0; i < part->n_blocks; i++) {
+    struct ucd_block *block = &ucd->blocks[ucd->n_blocks + i];
 
-      /* Get attributes of the block subheader */
-      for (attrs = node->properties; attrs; attrs = attrs->next) {
-        if (attrs->type == XML_ATTRIBUTE_NODE && strcmp((const char *) attrs->name, xmlAttrs.NAME) == 0) {
-          blockSub->name = allocateString(attrs->children->content);
-          if (blockSub->name == NULL) {
-            printf("Error in copying block subheader name\n");
-          }
-        }
-      }
+    *block = part->blocks[i];
+    block->name = rebaseString(block->name, ucd->strings_len);
+    block->first_tag += ucd->n_tags;
+    block->first_subheader += ucd->n_subheaders;
+    block->first_char += ucd->n_chars;
+  }
+  for (i = 0; i < part->n_subheaders; i++) {
+    struct ucd_subheader *sub = &ucd->subheaders[ucd->n_subheaders + i];
 
-      /* Parse subheader content */
-      parseSubHeaderContent(node->children, blockSub);
-    }
-    else if (strcmp((const char *) node->name, xmlTags.CHAR_ENTRY) == 0) {
-      currChar = emptyCharEntry();
+    *sub = part->subheaders[i];
+    sub->name = rebaseString(sub->name, ucd->strings_len);
+    sub->first_tag += ucd->n_tags;
+    sub->first_char += ucd->n_chars;
+  }
+  for (i = 0; i < part->n_chars; i++) {
+    struct ucd_char *entry = &ucd->chars[ucd->n_chars + i];
 
-      /* Connect new char entry with the previous one */
-      if (prevChar != NULL) {
-        prevChar->next = currChar;
-      }
-      prevChar = currChar;
+    *entry = part->chars[i];
+    entry->name = rebaseString(entry->name, ucd->strings_len);
+    entry->type = rebaseString(entry->type, ucd->strings_len);
+    entry->first_tag += ucd->n_tags;
+  }
+  for (i = 0; i < part->n_tags; i++) {
+    struct ucd_tag *tag = &ucd->tags[ucd->n_tags + i];
 
-      /* Assign the first char entry */
-      if (block->chars == NULL) {
-        block->chars = currChar;
-      }
+    *tag = part->tags[i];
+    tag->content = rebaseString(tag->content, ucd->strings_len);
+    tag->first_attr += ucd->n_attrs;
+  }
+  for (i = 0; i < part->n_attrs; i++) {
+    struct ucd_attr *attr = &ucd->attrs[ucd->n_attrs + i];
 
-      parseCharEntry(currChar, node);
-    }
-    else {
-      currSmpl = emptySimpleTag();
+    attr->name = part->attrs[i].name + ucd->strings_len;
+    attr->value = part->attrs[i].value + ucd->strings_len;
+  }
+  if (part->strings_len)
+    memcpy(ucd->strings + ucd->strings_len, part->strings, part->strings_len);
+
+  ucd->n_blocks += part->n_blocks;
+  ucd->n_subheaders += part->n_subheaders;
+  ucd->n_chars += part->n_chars;
+  ucd->n_tags += part->n_tags;
+  ucd->n_attrs += part->n_attrs;
+  ucd->strings_len += part->strings_len;
+  free_ucd_data(part);
+  return 0;
+}
 
-      /* Connect new simple tag with the previous one */
-      if (prevSmpl != NULL) {
-        prevSmpl->next = currSmpl;
-      }
-      prevSmpl = currSmpl;
+/* A part of the XML file with consecutive block headers, parsed by a worker */
+struct xmlChunk {
+  const char *fileName;
+  const char *prolog; /* everything up to and including the root start tag */
+  size_t prologLen;
+  const char *data;
+  size_t len;
+  const char *rootName;
+  size_t rootNameLen;
+  struct ucd_data *ucd;
+  int error;
+};
+
+/* Find 'needle' in [p, end), returns NULL if not found */
+static const char *findString(const char *p, const char *end, const char *needle) {
+  size_t len = strlen(needle);
+
+  for (; (p = memchr(p, needle[0], end - p)) != NULL; p++) {
+    if ((size_t) (end - p) < len)
+      return NULL;
+    if (memcmp(p, needle, len) == 0)
+      return p;
+  }
+  return NULL;
+}
 
-      /* Assign the first simple tag */
-      if (block->outer_tags == NULL) {
-        block->outer_tags = currSmpl;
-      }
+static int startsWith(const char *p, const char *end, const char *prefix) {
+  size_t len = strlen(prefix);
+  return (size_t) (end - p) >= len && memcmp(p, prefix, len) == 0;
+}
 
-      if (strcmp((const char *) node->name, xmlTags.NOTICE_LINE) == 0) {
-        parseSimpleTag(currSmpl, node, xmlTags.NOTICE_LINE, NULL);
-      }
-      else if (strcmp((const char *) node->name, xmlTags.CROSS_REF) == 0) {
-        parseSimpleTag(currSmpl, node, xmlTags.CROSS_REF, xmlAttrs.REF);
-      }
-      else if (strcmp((const char *) node->name, xmlTags.COMMENT_LINE) == 0) {
-        parseSimpleTag(currSmpl, node, xmlTags.COMMENT_LINE, xmlAttrs.CONTENT);
-      }
+static int isNameEnd(char c) {
+  return isspace((unsigned char) c) || c == '>' || c == '/';
+}
+
+/* Find the '>' ending the tag at 'p', skipping quoted attribute values */
+static const char *findTagEnd(const char *p, const char *end) {
+  char quote = 0;
+
+  for (; p < end; p++) {
+    if (quote) {
+      if (*p == quote)
+        quote = 0;
+    }
+    else if (*p == '"' || *p == '\'')
+      quote = *p;
+    else if (*p == '>')
+      return p;
+  }
+  return NULL;
+}
 
-    } /* end else */
-  } /* end for */
+/* Wrap the chunk into a copy of the root element and parse it */
+static gpointer parseChunk(gpointer data) {
+  struct xmlChunk *chunk = data;
+  size_t len = chunk->prologLen + chunk->len + chunk->rootNameLen + 3;
+  char *buf = malloc(len);
+  char *p;
+  xmlDoc *doc;
+  int64_t start;
+
+  trace_thread_name("ucd-parser");
+  if (!buf) {
+    chunk->error = 1;
+    return NULL;
+  }
+
+  p = buf;
+  memcpy(p, chunk->prolog, chunk->prologLen);
+  p += chunk->prologLen;
+  memcpy(p, chunk->data, chunk->len);
+  p += chunk->len;
+  *p++ = '<';
+  *p++ = '/';
+  memcpy(p, chunk->rootName, chunk->rootNameLen);
+  p += chunk->rootNameLen;
+  *p = '>';
+
+  start = trace_begin();
+  doc = xmlReadMemory(buf, len, chunk->fileName, NULL, 0);
+  free(buf);
+  trace_end("ucd", "parse XML chunk", start);
+  if (doc == NULL) {
+    chunk->error = 1;
+    return NULL;
+  }
+
+  start = trace_begin();
+  chunk->ucd = parse_ucd_from_xml(xmlDocGetRootElement(doc)->children);
+  xmlFreeDoc(doc);
+  trace_end("ucd", "build UCD arrays", start);
+  if (!chunk->ucd)
+    chunk->error = 1;
+  return NULL;
 }
 
 /*
- * Create a convenient representation of the XML file. Put all blocks into the list,
- * assign character entries and other useful information to them.
+ * Find offsets of all top level block headers (children of the root
+ * element), the end of the root start tag and the start of the root end
+ * tag. Comments, CDATA sections and processing instructions are skipped.
+ * Returns the number of block headers, or -1 if the file cannot be split
+ * (e.g. it has a DOCTYPE, which could define entities, or its elements
+ * are not nested properly).
  */
-struct header_block *parse_ucd_from_xml(const xmlNode *rootChildren) {
-  if (rootChildren != NULL) {
-    const xmlNode *node = NULL;
-    xmlAttr *attrs = NULL;
-    struct header_block* firstBlock = NULL;
-    struct header_block* blockHead = NULL;
-    struct header_block* prevBlock = NULL;
-
-    /* Iterate through root children and ignore all tags except for block headers */
-    for (node = rootChildren; node; node = node->next) {
-      if (node->type == XML_ELEMENT_NODE && strcmp((const char *) node->name, xmlTags.BLOCK_HEADER) == 0) {
-        blockHead = emptyHeaderBlock();
-
-        /* Connect new block with the previous one */
-        if (prevBlock != NULL) {
-          prevBlock->next = blockHead;
-        }
-        prevBlock = blockHead;
+static long scanBlockHeaders(const char *data, size_t size, size_t **offsets,
+    size_t *rootStart, size_t *rootEnd, const char **rootName, size_t *rootNameLen) {
+  const char *end = data + size;
+  const char *p = data;
+  const char *name;
+  const char *rootClose;
+  const char *tagEnd;
+  size_t nameLen;
+  long count = 0, allocated = 0, depth = 0;
+
+  *offsets = NULL;
+
+  /* Skip the prolog and find the root element */
+  for (;;) {
+    p = memchr(p, '<', end - p);
+    if (!p)
+      return -1;
+    if (startsWith(p, end, "<?")) {
+      p = findString(p, end, "?>");
+    }
+    else if (startsWith(p, end, "<!--")) {
+      p = findString(p, end, "-->");
+    }
+    else if (p[1] == '!') {
+      return -1;
+    }
+    else break;
+    if (!p)
+      return -1;
+  }
 
-        /* Assign the first block */
-        if (firstBlock == NULL) {
-          firstBlock = blockHead;
-        }
+  name = p + 1;
+  for (nameLen = 0; name + nameLen < end && !isNameEnd(name[nameLen]); nameLen++)
+    ;
+  p = memchr(p, '>', end - p);
+  if (!p || nameLen == 0 || p[-1] == '/')
+    return -1;
+  *rootStart = p + 1 - data;
+
+  /* The root end tag is the last end tag of the document */
+  for (rootClose = end - 2; rootClose > p; rootClose--) {
+    if (rootClose[0] == '<' && rootClose[1] == '/')
+      break;
+  }
+  if (rootClose <= p || (size_t) (end - rootClose - 2) < nameLen
+      || memcmp(rootClose + 2, name, nameLen) != 0)
+    return -1;
+  *rootEnd = rootClose - data;
+  *rootName = name;
+  *rootNameLen = nameLen;
+
+  end = rootClose;
+  for (p++; (p = memchr(p, '<', end - p)) != NULL; p++) {
+    const char *skipEnd = NULL;
+
+    if (startsWith(p, end, "<!--"))
+      skipEnd = "-->";
+    else if (startsWith(p, end, "<![CDATA["))
+      skipEnd = "]]>";
+    else if (startsWith(p, end, "<?"))
+      skipEnd = "?>";
+
+    if (skipEnd) {
+      p = findString(p, end, skipEnd);
+      if (!p)
+        break;
+      continue;
+    }
 
-        /* Get attributes of the block header */
-        for (attrs = node->properties; attrs; attrs = attrs->next) {
-          /* Continue only with an attribute */
-          if (attrs->type != XML_ATTRIBUTE_NODE) {
-            continue;
-          }
-
-          if (strcmp((const char *) attrs->name, xmlAttrs.BLOCK_START) == 0) {
-            if (sscanf((const char *) attrs->children->content, "%lX", &blockHead->start) != 1) {
-              printf("Parse error in block header start\n");
-            }
-          }
-          else if (strcmp((const char *) attrs->name, xmlAttrs.BLOCK_END) == 0) {
-            if (sscanf((const char *) attrs->children->content, "%lX", &blockHead->end) != 1) {
-              printf("Parse error in block header end\n");
-            }
-          }
-          else if (strcmp((const char *) attrs->name, xmlAttrs.NAME) == 0) {
-            blockHead->name = allocateString(attrs->children->content);
-            if (blockHead->name == NULL) {
-              printf("Error in copying block header name\n");
-            }
-          }
+    tagEnd = p + 1 < end && p[1] != '!' ? findTagEnd(p, end) : NULL;
+    if (!tagEnd || (p[1] == '/' && --depth < 0)) {
+      free(*offsets);
+      *offsets = NULL;
+      return -1;
+    }
+    if (!depth && startsWith(p, end, "<block_header") && p + 13 < end
+        && isNameEnd(p[13])) {
+      if (count == allocated) {
+        size_t *newOffsets;
+
+        allocated = allocated ? allocated * 2 : 512;
+        newOffsets = realloc(*offsets, allocated * sizeof(**offsets));
+        if (!newOffsets) {
+          free(*offsets);
+          *offsets = NULL;
+          return -1;
         }
-
-        parseBlockHeaderContent(node->children, blockHead);
+        *offsets = newOffsets;
       }
+      (*offsets)[count++] = p - data;
     }
+    if (p[1] != '/' && tagEnd[-1] != '/')
+      depth++;
+    p = tagEnd;
+  }
 
-    return firstBlock;
+  if (depth) {
+    free(*offsets);
+    *offsets = NULL;
+    return -1;
   }
+  return count;
+}
 
-  return NULL;
+/* Parse the whole file at once, used when it cannot be split */
+static int parseSequentially(const char *fileName, struct ucd_data **ucd) {
+  int64_t start = trace_begin();
+  xmlDoc *doc = xmlReadFile(fileName, NULL, 0);
+
+  trace_end("ucd", "parse XML", start);
+  if (doc == NULL)
+    return -1;
+
+  start = trace_begin();
+  *ucd = parse_ucd_from_xml(xmlDocGetRootElement(doc)->children);
+  xmlFreeDoc(doc);
+  trace_end("ucd", "build UCD arrays", start);
+  if (!*ucd)
+    return -1;
+  sortBlocks(*ucd);
+  return 0;
 }
 
-/* Find the block header with the given character code */
-const struct header_block* find_ucd_block(const struct header_block* firstBlock,
-    const unsigned long cp) {
-  const struct header_block *block;
+int parse_ucd_xml_file(const char *file_name, struct ucd_data **ucd) {
+  struct xmlChunk *chunks;
+  GThread **threads;
+  struct stat st;
+  const char *data, *rootName;
+  size_t *offsets, rootStart, rootEnd, rootNameLen;
+  long nblocks, i, block;
+  unsigned int nthreads, n;
+  int fd, error = 0;
+
+  *ucd = NULL;
+
+  /* libxml2 must be initialized before it is used from several threads */
+  xmlInitParser();
+
+  fd = open(file_name, O_RDONLY);
+  if (fd == -1)
+    return -1;
+  if (fstat(fd, &st) || st.st_size == 0) {
+    close(fd);
+    return parseSequentially(file_name, ucd);
+  }
+  data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED)
+    return parseSequentially(file_name, ucd);
+
+  nblocks = scanBlockHeaders(data, st.st_size, &offsets, &rootStart, &rootEnd, &rootName,
+      &rootNameLen);
+
+  nthreads = 0;
+  if (nblocks > 0) {
+    nthreads = g_get_num_processors();
+    if (nthreads > (rootEnd - rootStart) / CHUNK_SIZE_MIN)
+      nthreads = (rootEnd - rootStart) / CHUNK_SIZE_MIN;
+    if (nthreads > (unsigned long) nblocks)
+      nthreads = nblocks;
+  }
+
+  if (nthreads < 2) {
+    free(offsets);
+    munmap((void *) data, st.st_size);
+    return parseSequentially(file_name, ucd);
+  }
 
-  for (block = firstBlock; block; block = block->next) {
-    if ((cp >= block->start) && (cp <= block->end))
-      return block;
+  chunks = calloc(nthreads, sizeof(*chunks));
+  threads = calloc(nthreads, sizeof(*threads));
+  if (!chunks || !threads) {
+    free(chunks);
+    free(threads);
+    free(offsets);
+    munmap((void *) data, st.st_size);
+    return -1;
+  }
+
+  /* Split at block headers into chunks of about the same size */
+  for (n = 0, block = 0; n < nthreads && block < nblocks; n++) {
+    size_t start = n == 0 ? rootStart : offsets[block];
+    size_t target = rootStart + (rootEnd - rootStart) / nthreads * (n + 1);
+    size_t chunkEnd;
+
+    block++;
+    while (block < nblocks && (offsets[block] < target || n == nthreads - 1))
+      block++;
+    chunkEnd = block < nblocks ? offsets[block] : rootEnd;
+
+    chunks[n].fileName = file_name;
+    chunks[n].prolog = data;
+    chunks[n].prologLen = rootStart;
+    chunks[n].data = data + start;
+    chunks[n].len = chunkEnd - start;
+    chunks[n].rootName = rootName;
+    chunks[n].rootNameLen = rootNameLen;
   }
-  return NULL;
-}
 
+  /* The calling thread parses the first chunk itself */
+  for (i = 1; i < n; i++)
+    threads[i] = g_thread_new("ucd-parser", parseChunk, &chunks[i]);
+  parseChunk(&chunks[0]);
+  for (i = 1; i < n; i++)
+    g_thread_join(threads[i]);
+
+  /* Join the parts in the document order */
+  for (i = 0; i < n; i++)
+    error |= chunks[i].error;
+  if (!error) {
+    int64_t start = trace_begin();
+
+    *ucd = chunks[0].ucd;
+    for (i = 1; i < n && !error; i++)
+      error = appendUcdData(*ucd, chunks[i].ucd);
+    if (error) {
+      for (; i < n; i++)
+        free_ucd_data(chunks[i].ucd);
+      free_ucd_data(*ucd);
+      *ucd = NULL;
+    }
+    else sortBlocks(*ucd);
+    trace_end("ucd", "join UCD arrays", start);
+  }
+  else {
+    for (i = 0; i < n; i++)
+      free_ucd_data(chunks[i].ucd);
+  }
+
+  free(chunks);
+  free(threads);
+  free(offsets);
+  munmap((void *) data, st.st_size);
+
+  /*
+   * A chunk can fail where the whole file does not, e.g. if it uses
+   * something declared in an earlier chunk. The parser decides.
+   */
+  if (error)
+    return parseSequentially(file_name, ucd);
+  return 0;
+}
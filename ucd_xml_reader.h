@@ -8,6 +8,7 @@
 #define UCDXMLREADER_H_
 
 #include <stdio.h>
+#include <stdint.h>
 #include <libxml/parser.h>
 #include <libxml/tree.h>
 
@@ -55,56 +56,109 @@ extern const struct XmlTag xmlTags;
 extern const struct XmlAttr xmlAttrs;
 extern const struct YesNo yesNoValues;
 
-/* A simple structure for XML tags */
-struct tag_attr {
-  const char *name;
-  const char *value;
-  struct tag_attr *next;
+/* Kinds of the tags of blocks, subheaders and character entries */
+enum ucd_tag_kind {
+  UCD_NOTICE_LINE,
+  UCD_COMMENT_LINE,
+  UCD_CROSS_REF,
+  UCD_ALIAS_LINE,
+  UCD_FORMALALIAS_LINE,
+  UCD_VARIATION_LINE,
+  UCD_DECOMPOSITION,
+  UCD_COMPAT_MAPPING
 };
 
-/* A container for all information connected with character entries and blocks (notice lines,
- * crossed references, aliases, etc. */
-struct simple_tag {
-  const char *name;
-  const char *content;
-  struct tag_attr *info;
-  struct simple_tag *next;
+/*
+ * UCD data is kept in flat arrays. Blocks, subheaders and character
+ * entries are stored in the document order (sorted by code point) and
+ * refer to their children by ranges of indices into the next array.
+ * Strings are offsets into a shared string table, UCD_NO_STRING if
+ * missing; use ucd_string() to get them.
+ */
+#define UCD_NO_STRING UINT32_MAX
+
+/* Additional attribute of a tag (e.g. with_asterisk of a notice line) */
+struct ucd_attr {
+  uint32_t name;
+  uint32_t value;
 };
 
-/* The info about a char. It has a handle for the next char in the block */
-struct char_entry {
-  const char *name;
-  unsigned long cp;
-  const char *type;
-  struct simple_tag *char_info;
-  struct char_entry *next;
+/* Notice lines, cross references, aliases, etc. */
+struct ucd_tag {
+  enum ucd_tag_kind kind;
+  uint32_t content;
+  uint32_t first_attr;
+  uint32_t n_attrs;
 };
 
-struct subheader_block {
-  unsigned long start;
-  unsigned long end;
-  const char *name;
-  struct simple_tag *outer_tags;
-  struct char_entry *chars;
-  struct subheader_block* next;
+/* The info about a char */
+struct ucd_char {
+  uint32_t cp;
+  uint32_t name;
+  uint32_t type;
+  uint32_t first_tag;
+  uint32_t n_tags;
+};
+
+struct ucd_subheader {
+  uint32_t start;
+  uint32_t end;
+  uint32_t name;
+  uint32_t first_tag;
+  uint32_t n_tags;
+  uint32_t first_char;
+  uint32_t n_chars;
 };
 
 /* The structure of a block (with start and end for better search results) */
-struct header_block {
-  unsigned long start;
-  unsigned long end;
-  const char *name;
-  struct char_entry *chars;
-  struct simple_tag *outer_tags;
-  struct subheader_block* subheaders;
-  struct header_block *next;
+struct ucd_block {
+  uint32_t start;
+  uint32_t end;
+  uint32_t name;
+  uint32_t first_tag;
+  uint32_t n_tags;
+  uint32_t first_subheader;
+  uint32_t n_subheaders;
+  uint32_t first_char; /* entries outside of subheaders */
+  uint32_t n_chars;
+};
+
+struct ucd_data {
+  struct ucd_block *blocks;
+  uint32_t n_blocks;
+  struct ucd_subheader *subheaders;
+  uint32_t n_subheaders;
+  struct ucd_char *chars;
+  uint32_t n_chars;
+  struct ucd_tag *tags;
+  uint32_t n_tags;
+  struct ucd_attr *attrs;
+  uint32_t n_attrs;
+  char *strings;
+  uint32_t strings_len;
 };
 
-/* Parse the XML DOM returned by the libxml to the convenient representation of UCD data */
-struct header_block *parse_ucd_from_xml(const xmlNode *root);
+static inline const char *ucd_string(const struct ucd_data *ucd, uint32_t s) {
+  return s == UCD_NO_STRING ? NULL : ucd->strings + s;
+}
+
+/*
+ * Parse the XML DOM returned by the libxml to the convenient representation
+ * of UCD data. Returns NULL on error.
+ */
+struct ucd_data *parse_ucd_from_xml(const xmlNode *root);
+
+/*
+ * Read and parse the UCD XML file. Large files are split at block headers
+ * and the parts are parsed in parallel. Returns -1 on error.
+ */
+int parse_ucd_xml_file(const char *file_name, struct ucd_data **ucd);
+
+/* Free the data returned by parse_ucd_from_xml() */
+void free_ucd_data(struct ucd_data *ucd);
 
 /* Find the block with given character code point */
-const struct header_block* find_ucd_block(const struct header_block* first,
-    const unsigned long cp);
+const struct ucd_block *find_ucd_block(const struct ucd_data *ucd,
+    unsigned long cp);
 
 #endif /* UCDXMLREADER_H_ */